@@ -1,4 +1,6 @@
 dxc -T vs_6_0 -E Main -spirv -Fo DefaultVertex.spv DefaultVertex.hlsl
 dxc -T ps_6_0 -E Main -spirv -Fo DefaultFragment.spv DefaultFragment.hlsl
+dxc -T vs_6_0 -E Main -spirv -Fo DefaultBindlessVertex.spv DefaultBindlessVertex.hlsl
+dxc -T ps_6_0 -E Main -spirv -Fo DefaultBindlessFragment.spv DefaultBindlessFragment.hlsl
 
 pause
\ No newline at end of file
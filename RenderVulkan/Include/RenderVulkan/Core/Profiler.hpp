@@ -0,0 +1,268 @@
+#pragma once
+
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+#define Profiler_Concatenate_(a, b) a##b
+#define Profiler_Concatenate(a, b) Profiler_Concatenate_(a, b)
+
+#ifdef RENDERVULKAN_PROFILE
+#define Profiler_Scope(name) RenderVulkan::Core::ProfilerScope Profiler_Concatenate(profilerScope, __LINE__)(name)
+#define Profiler_Function() Profiler_Scope(__FUNCTION__)
+#define Profiler_EndFrame() RenderVulkan::Core::Profiler::GetInstance()->EndFrame()
+#define Profiler_BeginCapture(frameCount, path) RenderVulkan::Core::Profiler::GetInstance()->BeginCapture(frameCount, path)
+#else
+#define Profiler_Scope(name)
+#define Profiler_Function()
+#define Profiler_EndFrame()
+#define Profiler_BeginCapture(frameCount, path)
+#endif
+
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Core
+	{
+		class Profiler
+		{
+
+		public:
+
+			Profiler(const Profiler&) = delete;
+			Profiler& operator=(const Profiler&) = delete;
+
+			void BeginCapture(uint frameCount, const String& path)
+			{
+				if (frameCount == 0 || isCapturing.load(std::memory_order_acquire))
+					return;
+
+				capturePath = path;
+				framesRemaining = frameCount;
+				capturedFrames = 0;
+				captureStart = Clock::now();
+
+				captureGeneration.fetch_add(1, std::memory_order_release);
+				isCapturing.store(true, std::memory_order_release);
+
+				Logger_WriteConsole(Formatter::Format("Capturing '{}' frames to '{}'", frameCount, path), LogLevel::INFORMATION);
+			}
+
+			void EndFrame()
+			{
+				if (!IsCapturing())
+					return;
+
+				capturedFrames++;
+
+				if (--framesRemaining > 0)
+					return;
+
+				isCapturing.store(false, std::memory_order_release);
+
+				Export(capturePath);
+			}
+
+			bool IsCapturing() const
+			{
+				return isCapturing.load(std::memory_order_relaxed);
+			}
+
+			void Record(const char* name, TimePoint start, TimePoint end)
+			{
+				ThreadBuffer& buffer = GetThreadBuffer();
+
+				ullong generation = captureGeneration.load(std::memory_order_acquire);
+
+				if (buffer.generation.load(std::memory_order_relaxed) != generation)
+				{
+					buffer.count.store(0, std::memory_order_relaxed);
+					buffer.dropped = 0;
+					buffer.generation.store(generation, std::memory_order_release);
+				}
+
+				Size index = buffer.count.load(std::memory_order_relaxed);
+
+				if (index >= buffer.events.size())
+				{
+					buffer.dropped++;
+					return;
+				}
+
+				buffer.events[index] = { name, ToMicroseconds(start), ToMicroseconds(end) };
+				buffer.count.store(index + 1, std::memory_order_release);
+			}
+
+			void Export(const String& path)
+			{
+				OutputFileStream file(path, std::ios::binary | std::ios::trunc);
+
+				if (!file.is_open())
+				{
+					Logger_WriteConsole(Formatter::Format("Failed to open '{}' for the profiler capture", path), LogLevel::ERROR);
+					return;
+				}
+
+				ullong generation = captureGeneration.load(std::memory_order_acquire);
+				Size eventCount = 0;
+				Size droppedCount = 0;
+				bool isFirst = true;
+
+				file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+				LockGuard<Mutex> lock(registryMutex);
+
+				for (const Shared<ThreadBuffer>& buffer : threadBuffers)
+				{
+					if (buffer->generation.load(std::memory_order_acquire) != generation)
+						continue;
+
+					Size count = buffer->count.load(std::memory_order_acquire);
+
+					file << (isFirst ? "" : ",") << Formatter::Format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}", buffer->threadId, buffer->threadId == 0 ? "Main" : Formatter::Format("Thread {}", buffer->threadId));
+					isFirst = false;
+
+					for (Size e = 0; e < count; e++)
+					{
+						const ProfilerEvent& event = buffer->events[e];
+
+						file << Formatter::Format(",{{\"name\":\"{}\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}", Escape(event.name), buffer->threadId, event.start, event.end - event.start);
+					}
+
+					eventCount += count;
+					droppedCount += buffer->dropped;
+				}
+
+				file << "]}";
+
+				Logger_WriteConsole(Formatter::Format("Wrote '{}' events over '{}' frames to '{}'", eventCount, capturedFrames, path), LogLevel::INFORMATION);
+
+				if (droppedCount > 0)
+					Logger_WriteConsole(Formatter::Format("Dropped '{}' events because a thread buffer was full", droppedCount), LogLevel::WARNING);
+			}
+
+			static Profiler* Get()
+			{
+				static Profiler* profiler = GetInstance().get();
+
+				return profiler;
+			}
+
+			static Shared<Profiler> GetInstance()
+			{
+				class EnabledProfiler : public Profiler { };
+
+				static Shared<Profiler> instance = std::make_shared<EnabledProfiler>();
+
+				return instance;
+			}
+
+			static constexpr Size EVENTS_PER_THREAD = 1 << 16;
+
+		private:
+
+			struct ProfilerEvent
+			{
+				const char* name;
+				double start;
+				double end;
+			};
+
+			struct ThreadBuffer
+			{
+				uint threadId = 0;
+
+				Vector<ProfilerEvent> events;
+
+				Atomic<ullong> generation = 0;
+				Atomic<Size> count = 0;
+				Size dropped = 0;
+			};
+
+			Profiler() = default;
+
+			ThreadBuffer& GetThreadBuffer()
+			{
+				thread_local Shared<ThreadBuffer> buffer = RegisterThread();
+
+				return *buffer;
+			}
+
+			Shared<ThreadBuffer> RegisterThread()
+			{
+				Shared<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>();
+
+				buffer->events.resize(EVENTS_PER_THREAD);
+
+				LockGuard<Mutex> lock(registryMutex);
+
+				buffer->threadId = static_cast<uint>(threadBuffers.size());
+				threadBuffers.push_back(buffer);
+
+				return buffer;
+			}
+
+			double ToMicroseconds(TimePoint time) const
+			{
+				return std::chrono::duration<double, std::micro>(time - captureStart).count();
+			}
+
+			static String Escape(const char* name)
+			{
+				String escaped;
+
+				for (const char* character = name; *character != '\0'; character++)
+				{
+					if (*character == '"' || *character == '\\')
+						escaped += '\\';
+
+					escaped += *character;
+				}
+
+				return escaped;
+			}
+
+			AtomicBool isCapturing = false;
+			Atomic<ullong> captureGeneration = 0;
+
+			uint framesRemaining = 0;
+			uint capturedFrames = 0;
+			TimePoint captureStart = {};
+			String capturePath;
+
+			Mutex registryMutex;
+			Vector<Shared<ThreadBuffer>> threadBuffers;
+
+		};
+
+		class ProfilerScope
+		{
+
+		public:
+
+			explicit ProfilerScope(const char* name) : name(name)
+			{
+				isActive = Profiler::Get()->IsCapturing();
+
+				if (isActive)
+					start = Clock::now();
+			}
+
+			~ProfilerScope()
+			{
+				if (isActive)
+					Profiler::Get()->Record(name, start, Clock::now());
+			}
+
+			ProfilerScope(const ProfilerScope&) = delete;
+			ProfilerScope& operator=(const ProfilerScope&) = delete;
+
+		private:
+
+			const char* name;
+			bool isActive = false;
+			TimePoint start = {};
+
+		};
+	}
+}
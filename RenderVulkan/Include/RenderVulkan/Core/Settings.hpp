@@ -25,7 +25,7 @@ namespace RenderVulkan
 				if (!registeredSettings.contains(key))
 					return T();
 
-				return std::any_cast<T>(registeredSettings[key]);
+				return std::any_cast<T>(registeredSettings.at(key));
 			}
 
 			template<typename T>
@@ -40,7 +40,7 @@ namespace RenderVulkan
 				if (!registeredSettings.contains(key))
 					return nullptr;
 
-				return reinterpret_cast<T>(std::any_cast<uint64_t>(registeredSettings[key]));
+				return reinterpret_cast<T>(std::any_cast<uint64_t>(registeredSettings.at(key)));
 			}
 
 			static Shared<Settings> GetInstance()
@@ -3,6 +3,7 @@
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 #include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Core/Profiler.hpp"
 
 namespace RenderVulkan
 {
@@ -43,6 +44,8 @@ namespace RenderVulkan
 
 			void Update()
 			{
+				Profiler_Function();
+
 				glfwPollEvents();
 			}
 
@@ -27,11 +27,32 @@ namespace RenderVulkan
 			virtual void Initialize() { }
 			virtual void Update() { }
 			virtual void Render(VkCommandBuffer commandBuffer) { }
+			virtual void RenderDepth(VkCommandBuffer commandBuffer) { }
 			virtual void CleanUp() { }
 
+			static void SetChangeListener(const Function<void()>& listener)
+			{
+				GetChangeListener() = listener;
+			}
+
+			static void NotifyChanged()
+			{
+				if (GetChangeListener())
+					GetChangeListener()();
+			}
+
 			Shared<GameObject> gameObject;
 			Shared<Transform> transform;
 
+		private:
+
+			static Function<void()>& GetChangeListener()
+			{
+				static Function<void()> listener;
+
+				return listener;
+			}
+
 		};
 	}
 }
\ No newline at end of file
@@ -27,6 +27,8 @@ namespace RenderVulkan
 				component->Initialize();
 
 				components[typeid(T)] = component;
+
+				Component::NotifyChanged();
 			};
 
 			template<typename T>
@@ -55,6 +57,8 @@ namespace RenderVulkan
 
 				if (components.contains(typeid(T)))
 					components.erase(typeid(T));
+
+				Component::NotifyChanged();
 			}
 
 			String GetName() const
@@ -74,6 +78,12 @@ namespace RenderVulkan
 					component->Render(commandBuffer);
 			}
 
+			void RenderDepth(VkCommandBuffer commandBuffer)
+			{
+				for (auto& [type, component] : components)
+					component->RenderDepth(commandBuffer);
+			}
+
 			void CleanUp()
 			{
 				for (auto& [type, component] : components)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "RenderVulkan/Core/Profiler.hpp"
 #include "RenderVulkan/ECS/GameObject.hpp"
 
 namespace RenderVulkan
@@ -17,31 +18,60 @@ namespace RenderVulkan
 			void Register(Shared<GameObject> gameObject)
 			{
 				registeredGameObjects[gameObject->GetName()] = gameObject;
+
+				RebuildRenderList();
 			}
 
 			void Unregister(const String& name)
 			{
 				registeredGameObjects.erase(name);
+
+				RebuildRenderList();
 			}
 
 			void Update()
 			{
+				Profiler_Function();
+
 				for (auto& [name, gameObject] : registeredGameObjects)
 					gameObject->Update();
 			}
 
 			void Render(VkCommandBuffer commandBuffer)
 			{
-				for (auto& [name, gameObject] : registeredGameObjects)
+				Profiler_Function();
+
+				for (auto& gameObject : renderList)
 					gameObject->Render(commandBuffer);
 			}
 
+			void Render(VkCommandBuffer commandBuffer, Size partition, Size partitionCount)
+			{
+				Profiler_Function();
+
+				Size partitionSize = (renderList.size() + partitionCount - 1) / partitionCount;
+				Size first = std::min(partition * partitionSize, renderList.size());
+				Size last = std::min(first + partitionSize, renderList.size());
+
+				for (Size g = first; g < last; g++)
+					renderList[g]->Render(commandBuffer);
+			}
+
+			void RenderDepth(VkCommandBuffer commandBuffer)
+			{
+				Profiler_Function();
+
+				for (auto& gameObject : renderList)
+					gameObject->RenderDepth(commandBuffer);
+			}
+
 			void CleanUp()
 			{
 				for (auto& [name, gameObject] : registeredGameObjects)
 					gameObject->CleanUp();
 
 				registeredGameObjects.clear();
+				renderList.clear();
 			}
 
 			static Shared<GameObjectManager> GetInstance()
@@ -56,7 +86,19 @@ namespace RenderVulkan
 
 			GameObjectManager() = default;
 
+			void RebuildRenderList()
+			{
+				renderList.clear();
+				renderList.reserve(registeredGameObjects.size());
+
+				for (auto& [name, gameObject] : registeredGameObjects)
+					renderList.push_back(gameObject);
+
+				Component::NotifyChanged();
+			}
+
 			UnorderedMap<String, Shared<GameObject>> registeredGameObjects;
+			Vector<Shared<GameObject>> renderList;
 
 		};
 	}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Core/Profiler.hpp"
 #include "RenderVulkan/Core/Settings.hpp"
 #include "RenderVulkan/ECS/GameObjectManager.hpp"
 #include "RenderVulkan/Render/Renderer.hpp"
@@ -25,6 +26,12 @@ namespace RenderVulkan
 
 			Settings::GetInstance()->Set<String>("windowTitle", "RenderVulkan* 0.1.3");
 			Settings::GetInstance()->Set<Vector2i>("windowDimensions", { 750, 450 });
+			Settings::GetInstance()->Set<uint>("framesInFlight", 2);
+			Settings::GetInstance()->Set<uint>("recordingThreads", 0);
+			Settings::GetInstance()->Set<bool>("commandBufferCaching", true);
+			Settings::GetInstance()->Set<bool>("gpuProfiling", true);
+			Settings::GetInstance()->Set<String>("profilerCapturePath", "capture.json");
+			Settings::GetInstance()->Set<String>("pipelineCachePath", "pipeline.cache");
 			Settings::GetInstance()->Set<Function<void(Vector2i)>>("windowResizeCallback", [](Vector2i dimensions)
 			{
 				if (!Renderer::GetInstance()->IsInitialized())
@@ -40,29 +47,21 @@ namespace RenderVulkan
 
 			Renderer::GetInstance()->Initialize();
 
-			Unique<DescriptorManager> descriptorManager = DescriptorManager::Create();
-
-			descriptorManager->CreateDescriptorSetLayout
-			({
-				{ 
-					0, 
-					VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 
-					1, 
-					VK_SHADER_STAGE_VERTEX_BIT, 
-					nullptr 
-				}
-			});
+			String defaultShaderPath = "Shader/Default";
 
-			descriptorManager->CreateDescriptorPool
-			({
-				{ 
-					VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 
-					1 
-				}
-			}, 1);
-			
-			ShaderManager::GetInstance()->Register(Shader::Create("Shader/Default", "default", std::move(descriptorManager)));
-			ShaderManager::GetInstance()->CreateShaderGraphicsPipelines(Renderer::GetInstance()->GetRenderPass());
+			if (BindlessManager::GetInstance()->IsEnabled())
+			{
+				if (std::filesystem::exists(Formatter::Format("Assets/{}/Shader/DefaultBindlessVertex.spv", Settings::GetInstance()->Get<String>("defaultDomain"))))
+					defaultShaderPath = "Shader/DefaultBindless";
+				else
+					Logger_WriteConsole("Bindless default shader is not compiled, using the bound default shader", LogLevel::WARNING);
+			}
+
+			ShaderManager::GetInstance()->Register(Shader::Create(defaultShaderPath, "default"));
+			CreatePipelines();
+
+			if (Settings::GetInstance()->Get<bool>("shaderHotReload"))
+				ShaderManager::GetInstance()->EnableHotReload();
 			
 			gameObject = GameObject::Create("gameObject");
 			GameObjectManager::GetInstance()->Register(gameObject);
@@ -87,10 +86,24 @@ namespace RenderVulkan
 			{ 
 				GameObjectManager::GetInstance()->Render(commandBuffer);
 			});
+
+			Renderer::GetInstance()->SetDepthRenderCallback([](VkCommandBuffer commandBuffer, int index)
+			{
+				GameObjectManager::GetInstance()->RenderDepth(commandBuffer);
+			});
+
+			Renderer::GetInstance()->SetParallelRenderCallback([](VkCommandBuffer commandBuffer, Size worker, Size workerCount)
+			{
+				GameObjectManager::GetInstance()->Render(commandBuffer, worker, workerCount);
+			});
+
+			Profiler_BeginCapture(Settings::GetInstance()->Get<uint>("profilerCaptureFrames"), Settings::GetInstance()->Get<String>("profilerCapturePath"));
 		}
 
 		void Update()
 		{
+			Profiler_Function();
+
 			gameObject->GetTransform()->Rotate({0.0f, 0.0f, -0.01f});
 
 			GameObjectManager::GetInstance()->Update();
@@ -98,13 +111,25 @@ namespace RenderVulkan
 
 		void Render()
 		{
+			Profiler_Function();
+
+			ShaderManager::GetInstance()->Update();
 			Renderer::GetInstance()->Render();
 		}
 
+		void SetSampleCount(uint samples)
+		{
+			Renderer::GetInstance()->SetSampleCount(samples);
+
+			CreatePipelines();
+		}
+
 		void CleanUp()
 		{
 			Logger_WriteConsole("Cleaning up engine...", LogLevel::INFORMATION);
 
+			PipelineStateCache::GetInstance()->StopBackgroundLinking();
+
 			GameObjectManager::GetInstance()->CleanUp();
 			ShaderManager::GetInstance()->CleanUp();
 			Renderer::GetInstance()->CleanUp();
@@ -119,6 +144,14 @@ namespace RenderVulkan
 
 	private:
 
+		void CreatePipelines()
+		{
+			ShaderManager::GetInstance()->CreateShaderGraphicsPipelines(Renderer::GetInstance()->GetRenderPass());
+
+			if (Renderer::GetInstance()->IsDepthPrepassEnabled())
+				ShaderManager::GetInstance()->CreateShaderDepthPipelines(Renderer::GetInstance()->GetDepthPrepassRenderPass());
+		}
+
 		Shared<GameObject> gameObject;
 
 	};
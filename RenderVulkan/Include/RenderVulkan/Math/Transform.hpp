@@ -107,6 +107,8 @@ namespace RenderVulkan
             {
                 if (!isDirty)
                     isDirty = true;
+
+                NotifyChanged();
             }
 
             void UpdateWorldMatrixIfNeeded()
@@ -0,0 +1,404 @@
+#pragma once
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Core/Settings.hpp"
+#include "RenderVulkan/Render/DeviceCapabilities.hpp"
+#include "RenderVulkan/Render/TimelineScheduler.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+using namespace RenderVulkan::Core;
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		class BindlessManager
+		{
+
+		public:
+
+			static constexpr uint SET_INDEX = 0;
+			static constexpr uint STORAGE_BUFFER_BINDING = 0;
+			static constexpr uint IMAGE_BINDING = 1;
+			static constexpr uint PUSH_CONSTANT_SIZE = 128;
+
+			BindlessManager(const BindlessManager&) = delete;
+			BindlessManager& operator=(const BindlessManager&) = delete;
+
+			void Initialize(Size frameCount)
+			{
+				device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
+				isEnabled = false;
+
+				framesInFlight = std::max<Size>(frameCount, 1);
+				frameIndex = 0;
+
+				if (!Settings::GetInstance()->Get<bool>("bindless"))
+					return;
+
+				if (!Settings::GetInstance()->Get<DeviceCapabilities>("deviceCapabilities").IsSupported(DeviceFeature::DESCRIPTOR_INDEXING))
+				{
+					Logger_WriteConsole("Descriptor indexing is not supported, bindless descriptors disabled", LogLevel::WARNING);
+					return;
+				}
+
+				VkPhysicalDeviceDescriptorIndexingProperties indexingProperties{};
+
+				indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+
+				VkPhysicalDeviceProperties2 properties{};
+
+				properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+				properties.pNext = &indexingProperties;
+
+				vkGetPhysicalDeviceProperties2(Settings::GetInstance()->GetPointer<VkPhysicalDevice>("physicalDevice"), &properties);
+
+				bufferCapacity = std::min({ MAX_BUFFER_COUNT, indexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers, indexingProperties.maxPerStageDescriptorUpdateAfterBindStorageBuffers });
+				imageCapacity = std::min({ MAX_IMAGE_COUNT, indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages, indexingProperties.maxDescriptorSetUpdateAfterBindSamplers, indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages, indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers });
+
+				if (!CreateDescriptorSet())
+				{
+					DestroyDescriptorSet();
+
+					Logger_WriteConsole("Failed to create the bindless descriptor set, bindless descriptors disabled", LogLevel::WARNING);
+					return;
+				}
+
+				pushConstantRange.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+				pushConstantRange.offset = 0;
+				pushConstantRange.size = PUSH_CONSTANT_SIZE;
+
+				isEnabled = true;
+
+				Logger_WriteConsole(Formatter::Format("Bindless descriptors enabled with room for '{}' buffers and '{}' images", bufferCapacity, imageCapacity), LogLevel::INFORMATION);
+			}
+
+			bool IsEnabled() const
+			{
+				return isEnabled;
+			}
+
+			VkDescriptorSetLayout GetDescriptorSetLayout() const
+			{
+				return descriptorSetLayout;
+			}
+
+			const VkPushConstantRange& GetPushConstantRange() const
+			{
+				return pushConstantRange;
+			}
+
+			uint RegisterBuffer(VkBuffer buffer, VkDeviceSize range)
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				uint index = Allocate(freeBufferIndices, nextBufferIndex, bufferCapacity, "buffer");
+
+				if (index == INVALID_INDEX)
+					return index;
+
+				VkDescriptorBufferInfo bufferInformation{};
+
+				bufferInformation.buffer = buffer;
+				bufferInformation.offset = 0;
+				bufferInformation.range = range;
+
+				VkWriteDescriptorSet descriptorWrite{};
+
+				descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				descriptorWrite.dstSet = descriptorSet;
+				descriptorWrite.dstBinding = STORAGE_BUFFER_BINDING;
+				descriptorWrite.dstArrayElement = index;
+				descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+				descriptorWrite.descriptorCount = 1;
+				descriptorWrite.pBufferInfo = &bufferInformation;
+
+				vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+
+				return index;
+			}
+
+			uint RegisterImage(VkImageView imageView, VkSampler sampler, VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				uint index = Allocate(freeImageIndices, nextImageIndex, imageCapacity, "image");
+
+				if (index == INVALID_INDEX)
+					return index;
+
+				VkDescriptorImageInfo imageInformation{};
+
+				imageInformation.imageView = imageView;
+				imageInformation.sampler = sampler;
+				imageInformation.imageLayout = imageLayout;
+
+				VkWriteDescriptorSet descriptorWrite{};
+
+				descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				descriptorWrite.dstSet = descriptorSet;
+				descriptorWrite.dstBinding = IMAGE_BINDING;
+				descriptorWrite.dstArrayElement = index;
+				descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+				descriptorWrite.descriptorCount = 1;
+				descriptorWrite.pImageInfo = &imageInformation;
+
+				vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+
+				return index;
+			}
+
+			void ReleaseBuffer(uint index)
+			{
+				Release(freeBufferIndices, index);
+			}
+
+			void ReleaseImage(uint index)
+			{
+				Release(freeImageIndices, index);
+			}
+
+			void BeginFrame(Size index)
+			{
+				frameIndex = static_cast<uint>(index % framesInFlight);
+			}
+
+			uint GetFrameIndex() const
+			{
+				return frameIndex;
+			}
+
+			Size GetFramesInFlight() const
+			{
+				return framesInFlight;
+			}
+
+			void Begin(VkCommandBuffer commandBuffer)
+			{
+				RecordingState& recording = GetRecordingState();
+
+				recording.commandBuffer = commandBuffer;
+				recording.isBound = false;
+			}
+
+			void Bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout)
+			{
+				RecordingState& recording = GetRecordingState();
+
+				if (recording.commandBuffer == commandBuffer && recording.isBound)
+				{
+					skippedBindCount++;
+					return;
+				}
+
+				vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, SET_INDEX, 1, &descriptorSet, 0, nullptr);
+
+				recording.commandBuffer = commandBuffer;
+				recording.isBound = true;
+
+				bindCount++;
+			}
+
+			void Invalidate()
+			{
+				GetRecordingState().isBound = false;
+			}
+
+			void CleanUp()
+			{
+				if (!isEnabled)
+					return;
+
+				Logger_WriteConsole(Formatter::Format("Bindless descriptors: '{}' buffers and '{}' images in use, '{}' set binds, '{}' redundant binds skipped", nextBufferIndex - freeBufferIndices.size(), nextImageIndex - freeImageIndices.size(), bindCount.load(), skippedBindCount.load()), LogLevel::INFORMATION);
+
+				DestroyDescriptorSet();
+
+				freeBufferIndices.clear();
+				freeImageIndices.clear();
+				nextBufferIndex = 0;
+				nextImageIndex = 0;
+
+				isEnabled = false;
+			}
+
+			static Shared<BindlessManager> GetInstance()
+			{
+				class EnabledBindlessManager : public BindlessManager { };
+
+				static Shared<BindlessManager> instance = std::make_shared<EnabledBindlessManager>();
+
+				return instance;
+			}
+
+			static constexpr uint INVALID_INDEX = NumericLimits<uint>::max();
+
+		private:
+
+			struct RecordingState
+			{
+				VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+				bool isBound = false;
+			};
+
+			static constexpr uint MAX_BUFFER_COUNT = 65536;
+			static constexpr uint MAX_IMAGE_COUNT = 16384;
+
+			BindlessManager() = default;
+
+			static RecordingState& GetRecordingState()
+			{
+				thread_local RecordingState recording;
+
+				return recording;
+			}
+
+			bool CreateDescriptorSet()
+			{
+				Array<VkDescriptorSetLayoutBinding, 2> bindings{};
+
+				bindings[0].binding = STORAGE_BUFFER_BINDING;
+				bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+				bindings[0].descriptorCount = bufferCapacity;
+				bindings[0].stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+
+				bindings[1].binding = IMAGE_BINDING;
+				bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+				bindings[1].descriptorCount = imageCapacity;
+				bindings[1].stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+
+				VkDescriptorBindingFlags bindingFlag = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+				Array<VkDescriptorBindingFlags, 2> bindingFlags = { bindingFlag, bindingFlag };
+
+				VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInformation{};
+
+				bindingFlagsInformation.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+				bindingFlagsInformation.bindingCount = static_cast<uint>(bindingFlags.size());
+				bindingFlagsInformation.pBindingFlags = bindingFlags.data();
+
+				VkDescriptorSetLayoutCreateInfo layoutInformation{};
+
+				layoutInformation.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+				layoutInformation.pNext = &bindingFlagsInformation;
+				layoutInformation.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+				layoutInformation.bindingCount = static_cast<uint>(bindings.size());
+				layoutInformation.pBindings = bindings.data();
+
+				VkResult result = vkCreateDescriptorSetLayout(device, &layoutInformation, nullptr, &descriptorSetLayout);
+				Logger_ThrowIfFailed(result, "Failed to create bindless descriptor set layout", false);
+
+				if (result != VK_SUCCESS)
+				{
+					descriptorSetLayout = VK_NULL_HANDLE;
+					return false;
+				}
+
+				Array<VkDescriptorPoolSize, 2> poolSizes =
+				{{
+					{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, bufferCapacity },
+					{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, imageCapacity }
+				}};
+
+				VkDescriptorPoolCreateInfo poolInformation{};
+
+				poolInformation.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+				poolInformation.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+				poolInformation.poolSizeCount = static_cast<uint>(poolSizes.size());
+				poolInformation.pPoolSizes = poolSizes.data();
+				poolInformation.maxSets = 1;
+
+				result = vkCreateDescriptorPool(device, &poolInformation, nullptr, &descriptorPool);
+				Logger_ThrowIfFailed(result, "Failed to create bindless descriptor pool", false);
+
+				if (result != VK_SUCCESS)
+				{
+					descriptorPool = VK_NULL_HANDLE;
+					return false;
+				}
+
+				VkDescriptorSetAllocateInfo allocationInformation{};
+
+				allocationInformation.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+				allocationInformation.descriptorPool = descriptorPool;
+				allocationInformation.descriptorSetCount = 1;
+				allocationInformation.pSetLayouts = &descriptorSetLayout;
+
+				result = vkAllocateDescriptorSets(device, &allocationInformation, &descriptorSet);
+				Logger_ThrowIfFailed(result, "Failed to allocate bindless descriptor set", false);
+
+				return result == VK_SUCCESS;
+			}
+
+			void DestroyDescriptorSet()
+			{
+				if (descriptorPool != VK_NULL_HANDLE)
+					vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+
+				if (descriptorSetLayout != VK_NULL_HANDLE)
+					vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
+
+				descriptorPool = VK_NULL_HANDLE;
+				descriptorSetLayout = VK_NULL_HANDLE;
+				descriptorSet = VK_NULL_HANDLE;
+			}
+
+			static uint Allocate(Vector<uint>& freeIndices, uint& nextIndex, uint capacity, const String& type)
+			{
+				if (!freeIndices.empty())
+				{
+					uint index = freeIndices.back();
+					freeIndices.pop_back();
+
+					return index;
+				}
+
+				if (nextIndex >= capacity)
+				{
+					Logger_ThrowException(Formatter::Format("Bindless {} array is full ('{}' entries)", type, capacity), false);
+					return INVALID_INDEX;
+				}
+
+				return nextIndex++;
+			}
+
+			void Release(Vector<uint>& freeIndices, uint index)
+			{
+				if (index == INVALID_INDEX || !isEnabled)
+					return;
+
+				TimelineScheduler::GetInstance()->OnLastSubmittedComplete([this, &freeIndices, index]()
+				{
+					LockGuard<Mutex> lock(mutex);
+
+					freeIndices.push_back(index);
+				});
+			}
+
+			VkDevice device = VK_NULL_HANDLE;
+			bool isEnabled = false;
+
+			VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+			VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+			VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+			VkPushConstantRange pushConstantRange{};
+
+			uint bufferCapacity = 0;
+			uint imageCapacity = 0;
+
+			Mutex mutex;
+			Vector<uint> freeBufferIndices;
+			Vector<uint> freeImageIndices;
+			uint nextBufferIndex = 0;
+			uint nextImageIndex = 0;
+
+			Size framesInFlight = 1;
+			uint frameIndex = 0;
+
+			Atomic<Size> bindCount = 0;
+			Atomic<Size> skippedBindCount = 0;
+
+		};
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		class ChangeTracker
+		{
+
+		public:
+
+			ChangeTracker(const ChangeTracker&) = delete;
+			ChangeTracker& operator=(const ChangeTracker&) = delete;
+
+			void Invalidate()
+			{
+				revision.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			ullong GetRevision() const
+			{
+				return revision.load(std::memory_order_relaxed);
+			}
+
+			static Shared<ChangeTracker> GetInstance()
+			{
+				class EnabledChangeTracker : public ChangeTracker { };
+
+				static Shared<ChangeTracker> instance = std::make_shared<EnabledChangeTracker>();
+
+				return instance;
+			}
+
+			static constexpr ullong NO_REVISION = NumericLimits<ullong>::max();
+
+		private:
+
+			ChangeTracker() = default;
+
+			Atomic<ullong> revision = 0;
+
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,282 @@
+#pragma once
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Core/Settings.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+using namespace RenderVulkan::Core;
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		struct DescriptorWrite
+		{
+			uint binding = 0;
+			VkDescriptorType type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+
+			VkBuffer buffer = VK_NULL_HANDLE;
+			VkDeviceSize offset = 0;
+			VkDeviceSize range = VK_WHOLE_SIZE;
+
+			VkImageView imageView = VK_NULL_HANDLE;
+			VkSampler sampler = VK_NULL_HANDLE;
+			VkImageLayout imageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+			static DescriptorWrite Buffer(uint binding, VkDescriptorType type, VkBuffer buffer, VkDeviceSize range, VkDeviceSize offset = 0)
+			{
+				DescriptorWrite write;
+
+				write.binding = binding;
+				write.type = type;
+				write.buffer = buffer;
+				write.offset = offset;
+				write.range = range;
+
+				return write;
+			}
+
+			static DescriptorWrite Image(uint binding, VkDescriptorType type, VkImageView imageView, VkSampler sampler, VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+			{
+				DescriptorWrite write;
+
+				write.binding = binding;
+				write.type = type;
+				write.imageView = imageView;
+				write.sampler = sampler;
+				write.imageLayout = imageLayout;
+
+				return write;
+			}
+
+			bool operator==(const DescriptorWrite& other) const
+			{
+				return binding == other.binding && type == other.type && buffer == other.buffer && offset == other.offset && range == other.range && imageView == other.imageView && sampler == other.sampler && imageLayout == other.imageLayout;
+			}
+		};
+
+		class DescriptorAllocator
+		{
+
+		public:
+
+			DescriptorAllocator(const DescriptorAllocator&) = delete;
+			DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+
+			VkDescriptorSet Allocate(VkDescriptorSetLayout layout, const Vector<DescriptorWrite>& writes = {})
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				if (recycledSets.contains(layout) && !recycledSets[layout].empty())
+				{
+					VkDescriptorSet descriptorSet = recycledSets[layout].back();
+					recycledSets[layout].pop_back();
+
+					Update(descriptorSet, writes);
+
+					return descriptorSet;
+				}
+
+				if (currentPool == VK_NULL_HANDLE)
+					currentPool = CreatePool();
+
+				if (currentPool == VK_NULL_HANDLE)
+					return VK_NULL_HANDLE;
+
+				VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+				VkResult result = AllocateFromPool(currentPool, layout, descriptorSet);
+
+				if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL)
+				{
+					currentPool = CreatePool();
+
+					if (currentPool == VK_NULL_HANDLE)
+						return VK_NULL_HANDLE;
+
+					result = AllocateFromPool(currentPool, layout, descriptorSet);
+				}
+
+				Logger_ThrowIfFailed(result, "Failed to allocate descriptor set", false);
+
+				if (result != VK_SUCCESS)
+					return VK_NULL_HANDLE;
+
+				allocatedCount++;
+
+				Update(descriptorSet, writes);
+
+				return descriptorSet;
+			}
+
+			void Release(VkDescriptorSetLayout layout, VkDescriptorSet descriptorSet)
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				recycledSets[layout].push_back(descriptorSet);
+			}
+
+			void Reserve(const Vector<VkDescriptorPoolSize>& setPoolSizes)
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				bool isGrown = false;
+
+				for (const VkDescriptorPoolSize& poolSize : setPoolSizes)
+				{
+					uint& descriptorCount = descriptorsPerSet[poolSize.type];
+
+					if (poolSize.descriptorCount > descriptorCount)
+					{
+						descriptorCount = poolSize.descriptorCount;
+						isGrown = true;
+					}
+				}
+
+				if (isGrown)
+					currentPool = VK_NULL_HANDLE;
+			}
+
+			Size GetAllocatedCount() const
+			{
+				return allocatedCount;
+			}
+
+			Size GetPoolCount()
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				return pools.size();
+			}
+
+			void CleanUp()
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				for (VkDescriptorPool pool : pools)
+					vkDestroyDescriptorPool(device, pool, nullptr);
+
+				pools.clear();
+				recycledSets.clear();
+				descriptorsPerSet.clear();
+				currentPool = VK_NULL_HANDLE;
+				allocatedCount = 0;
+			}
+
+			static void Update(VkDescriptorSet descriptorSet, const Vector<DescriptorWrite>& writes)
+			{
+				if (writes.empty())
+					return;
+
+				Vector<VkDescriptorBufferInfo> bufferInformation(writes.size());
+				Vector<VkDescriptorImageInfo> imageInformation(writes.size());
+				Vector<VkWriteDescriptorSet> descriptorWrites(writes.size());
+
+				for (Size w = 0; w < writes.size(); w++)
+				{
+					const DescriptorWrite& write = writes[w];
+					VkWriteDescriptorSet& descriptorWrite = descriptorWrites[w];
+
+					descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+					descriptorWrite.dstSet = descriptorSet;
+					descriptorWrite.dstBinding = write.binding;
+					descriptorWrite.dstArrayElement = 0;
+					descriptorWrite.descriptorType = write.type;
+					descriptorWrite.descriptorCount = 1;
+
+					if (write.buffer != VK_NULL_HANDLE)
+					{
+						bufferInformation[w] = { write.buffer, write.offset, write.range };
+						descriptorWrite.pBufferInfo = &bufferInformation[w];
+					}
+					else
+					{
+						imageInformation[w] = { write.sampler, write.imageView, write.imageLayout };
+						descriptorWrite.pImageInfo = &imageInformation[w];
+					}
+				}
+
+				vkUpdateDescriptorSets(Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice"), static_cast<uint>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+			}
+
+			static Unique<DescriptorAllocator> Create(uint initialSetsPerPool = 64, uint maximumSetsPerPool = 4096)
+			{
+				class EnabledDescriptorAllocator : public DescriptorAllocator { };
+
+				Unique<DescriptorAllocator> allocator = std::make_unique<EnabledDescriptorAllocator>();
+
+				allocator->device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
+				allocator->setsPerPool = std::max(initialSetsPerPool, 1u);
+				allocator->maximumSetsPerPool = std::max(maximumSetsPerPool, allocator->setsPerPool);
+
+				return allocator;
+			}
+
+		private:
+
+			DescriptorAllocator() = default;
+
+			VkResult AllocateFromPool(VkDescriptorPool pool, VkDescriptorSetLayout layout, VkDescriptorSet& descriptorSet) const
+			{
+				VkDescriptorSetAllocateInfo allocationInformation{};
+
+				allocationInformation.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+				allocationInformation.descriptorPool = pool;
+				allocationInformation.descriptorSetCount = 1;
+				allocationInformation.pSetLayouts = &layout;
+
+				return vkAllocateDescriptorSets(device, &allocationInformation, &descriptorSet);
+			}
+
+			VkDescriptorPool CreatePool()
+			{
+				Vector<VkDescriptorPoolSize> poolSizes;
+
+				for (const auto& [type, descriptorCount] : descriptorsPerSet)
+					poolSizes.push_back({ type, descriptorCount * setsPerPool });
+
+				if (poolSizes.empty())
+					poolSizes.push_back({ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, setsPerPool });
+
+				VkDescriptorPoolCreateInfo poolInformation{};
+
+				poolInformation.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+				poolInformation.poolSizeCount = static_cast<uint>(poolSizes.size());
+				poolInformation.pPoolSizes = poolSizes.data();
+				poolInformation.maxSets = setsPerPool;
+
+				VkDescriptorPool pool = VK_NULL_HANDLE;
+
+				VkResult result = vkCreateDescriptorPool(device, &poolInformation, nullptr, &pool);
+				Logger_ThrowIfFailed(result, "Failed to create descriptor pool", false);
+
+				if (result != VK_SUCCESS)
+					return VK_NULL_HANDLE;
+
+				pools.push_back(pool);
+
+				setsPerPool = std::min(setsPerPool * 2, maximumSetsPerPool);
+
+				return pool;
+			}
+
+			VkDevice device = VK_NULL_HANDLE;
+
+			Mutex mutex;
+
+			VkDescriptorPool currentPool = VK_NULL_HANDLE;
+			Vector<VkDescriptorPool> pools;
+
+			Map<VkDescriptorType, uint> descriptorsPerSet;
+			UnorderedMap<VkDescriptorSetLayout, Vector<VkDescriptorSet>> recycledSets;
+
+			uint setsPerPool = 64;
+			uint maximumSetsPerPool = 4096;
+
+			Atomic<Size> allocatedCount = 0;
+
+		};
+	}
+}
@@ -4,6 +4,9 @@
 #include <GLFW/glfw3.h>
 #include "RenderVulkan/Core/Logger.hpp"
 #include "RenderVulkan/Core/Settings.hpp"
+#include "RenderVulkan/Render/DescriptorSetCache.hpp"
+#include "RenderVulkan/Render/LayoutCache.hpp"
+#include "RenderVulkan/Render/ShaderReflection.hpp"
 #include "RenderVulkan/Util/Typedefs.hpp"
 
 using namespace RenderVulkan::Core;
@@ -20,68 +23,32 @@ namespace RenderVulkan
 
             void CreateDescriptorSetLayout(const Vector<VkDescriptorSetLayoutBinding>& bindings)
             {
-                VkDescriptorSetLayoutCreateInfo layoutInformation{};
+                layoutBindings = bindings;
+                descriptorSetLayout = LayoutCache::GetInstance()->GetDescriptorSetLayout(bindings);
 
-                layoutInformation.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-                layoutInformation.bindingCount = static_cast<uint32_t>(bindings.size());
-                layoutInformation.pBindings = bindings.data();
-
-                VkResult result = vkCreateDescriptorSetLayout(Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice"), &layoutInformation, nullptr, &descriptorSetLayout);
-                Logger_ThrowIfFailed(result, "Failed to create descriptor set layout", false);
+                DescriptorSetCache::GetInstance()->Reserve(ShaderReflection::GetPoolSizes(bindings, 1));
             }
 
-            void CreateDescriptorPool(const Vector<VkDescriptorPoolSize>& poolSizes, uint32_t maxSets)
+            void CreateDescriptorSets(const Vector<VkBuffer>& buffers, VkDeviceSize bufferSize)
             {
-                VkDescriptorPoolCreateInfo poolInformation{};
+                descriptorSets.clear();
 
-                poolInformation.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-                poolInformation.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
-                poolInformation.pPoolSizes = poolSizes.data();
-                poolInformation.maxSets = maxSets;
+                VkDescriptorType descriptorType = GetDescriptorType(0);
 
-                VkResult result = vkCreateDescriptorPool(Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice"), &poolInformation, nullptr, &descriptorPool);
-                Logger_ThrowIfFailed(result, "Failed to create descriptor pool", false);
+                for (VkBuffer buffer : buffers)
+                    descriptorSets.push_back(DescriptorSetCache::GetInstance()->GetOrCreate(descriptorSetLayout, { DescriptorWrite::Buffer(0, descriptorType, buffer, bufferSize) }));
             }
 
-            void CreateDescriptorSets(const Vector<VkBuffer>& buffers, VkDeviceSize bufferSize)
+            bool HasBinding(uint binding) const
             {
-                VkDevice device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
-
-                Vector<VkDescriptorSetLayout> layouts(maxSets, descriptorSetLayout);
-
-                VkDescriptorSetAllocateInfo allocInfo{};
-
-                allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-                allocInfo.descriptorPool = descriptorPool;
-                allocInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
-                allocInfo.pSetLayouts = layouts.data();
-
-                descriptorSets.resize(layouts.size());
-
-                VkResult result = vkAllocateDescriptorSets(device, &allocInfo, descriptorSets.data());
-
-                Logger_ThrowIfFailed(result, "Failed to allocate descriptor sets", false);
-
-                for (Size b = 0; b < buffers.size(); b++)
-                {
-                    VkDescriptorBufferInfo bufferInfo{};
-
-                    bufferInfo.buffer = buffers[b];
-                    bufferInfo.offset = 0;
-                    bufferInfo.range = bufferSize;
-
-                    VkWriteDescriptorSet descriptorWrite{};
+                return std::any_of(layoutBindings.begin(), layoutBindings.end(), [binding](const VkDescriptorSetLayoutBinding& layoutBinding) { return layoutBinding.binding == binding; });
+            }
 
-                    descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                    descriptorWrite.dstSet = descriptorSets[b];
-                    descriptorWrite.dstBinding = 0;
-                    descriptorWrite.dstArrayElement = 0;
-                    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-                    descriptorWrite.descriptorCount = 1;
-                    descriptorWrite.pBufferInfo = &bufferInfo;
+            VkDescriptorType GetDescriptorType(uint binding) const
+            {
+                auto iterator = std::find_if(layoutBindings.begin(), layoutBindings.end(), [binding](const VkDescriptorSetLayoutBinding& layoutBinding) { return layoutBinding.binding == binding; });
 
-                    vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
-                }
+                return iterator != layoutBindings.end() ? iterator->descriptorType : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
             }
 
             VkDescriptorSetLayout GetDescriptorSetLayout() const 
@@ -89,9 +56,9 @@ namespace RenderVulkan
                 return descriptorSetLayout; 
             }
 
-            VkDescriptorPool GetDescriptorPool() const 
-            { 
-                return descriptorPool;
+            const Vector<VkDescriptorSetLayoutBinding>& GetBindings() const
+            {
+                return layoutBindings;
             }
 
             const Vector<VkDescriptorSet>& GetDescriptorSets() const 
@@ -101,14 +68,6 @@ namespace RenderVulkan
 
             void CleanUp()
             {
-                VkDevice device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
-
-                if (descriptorPool != VK_NULL_HANDLE)
-                    vkDestroyDescriptorPool(device, descriptorPool, nullptr);
-                
-                if (descriptorSetLayout != VK_NULL_HANDLE)
-                    vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
-
                 descriptorSets.clear();
             }
 
@@ -123,11 +82,9 @@ namespace RenderVulkan
             DescriptorManager() = default;
 
             VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
-            VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+            Vector<VkDescriptorSetLayoutBinding> layoutBindings;
             Vector<VkDescriptorSet> descriptorSets;
 
-            uint maxSets = 1;
-
         };
     }
 }
\ No newline at end of file
@@ -0,0 +1,178 @@
+#pragma once
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Render/DescriptorAllocator.hpp"
+#include "RenderVulkan/Render/TimelineScheduler.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+using namespace RenderVulkan::Core;
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		class DescriptorSetCache
+		{
+
+		public:
+
+			DescriptorSetCache(const DescriptorSetCache&) = delete;
+			DescriptorSetCache& operator=(const DescriptorSetCache&) = delete;
+
+			VkDescriptorSet GetOrCreate(VkDescriptorSetLayout layout, Vector<DescriptorWrite> writes)
+			{
+				std::sort(writes.begin(), writes.end(), [](const DescriptorWrite& left, const DescriptorWrite& right) { return left.binding < right.binding; });
+
+				ullong hash = Hash(layout, writes);
+
+				LockGuard<Mutex> lock(mutex);
+
+				for (const Entry& entry : descriptorSets[hash])
+				{
+					if (entry.layout == layout && entry.writes == writes)
+					{
+						hitCount++;
+						return entry.descriptorSet;
+					}
+				}
+
+				if (!allocator)
+					allocator = DescriptorAllocator::Create();
+
+				VkDescriptorSet descriptorSet = allocator->Allocate(layout, writes);
+
+				if (descriptorSet != VK_NULL_HANDLE)
+					descriptorSets[hash].push_back({ layout, writes, descriptorSet });
+
+				return descriptorSet;
+			}
+
+			void Reserve(const Vector<VkDescriptorPoolSize>& setPoolSizes)
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				if (!allocator)
+					allocator = DescriptorAllocator::Create();
+
+				allocator->Reserve(setPoolSizes);
+			}
+
+			void Invalidate(VkBuffer buffer)
+			{
+				Vector<Pair<VkDescriptorSetLayout, VkDescriptorSet>> invalidated;
+
+				{
+					LockGuard<Mutex> lock(mutex);
+
+					for (auto& [hash, bucket] : descriptorSets)
+					{
+						std::erase_if(bucket, [&](const Entry& entry)
+						{
+							if (std::none_of(entry.writes.begin(), entry.writes.end(), [buffer](const DescriptorWrite& write) { return write.buffer == buffer; }))
+								return false;
+
+							invalidated.push_back({ entry.layout, entry.descriptorSet });
+							return true;
+						});
+					}
+				}
+
+				if (invalidated.empty())
+					return;
+
+				TimelineScheduler::GetInstance()->OnLastSubmittedComplete([invalidated]()
+				{
+					DescriptorSetCache::GetInstance()->Release(invalidated);
+				});
+			}
+
+			void CleanUp()
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				if (!allocator)
+					return;
+
+				Logger_WriteConsole(Formatter::Format("Descriptor set cache: '{}' sets in '{}' pools, '{}' reuses", allocator->GetAllocatedCount(), allocator->GetPoolCount(), hitCount), LogLevel::INFORMATION);
+
+				allocator->CleanUp();
+				allocator.reset();
+
+				descriptorSets.clear();
+				hitCount = 0;
+			}
+
+			static Shared<DescriptorSetCache> GetInstance()
+			{
+				class EnabledDescriptorSetCache : public DescriptorSetCache { };
+
+				static Shared<DescriptorSetCache> instance = std::make_shared<EnabledDescriptorSetCache>();
+
+				return instance;
+			}
+
+		private:
+
+			struct Entry
+			{
+				VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+				Vector<DescriptorWrite> writes;
+				VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+			};
+
+			DescriptorSetCache() = default;
+
+			void Release(const Vector<Pair<VkDescriptorSetLayout, VkDescriptorSet>>& invalidated)
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				if (!allocator)
+					return;
+
+				for (const auto& [layout, descriptorSet] : invalidated)
+					allocator->Release(layout, descriptorSet);
+			}
+
+			static ullong Hash(VkDescriptorSetLayout layout, const Vector<DescriptorWrite>& writes)
+			{
+				ullong hash = 14695981039346656037ull;
+
+				auto combine = [&hash](ullong value)
+				{
+					for (int b = 0; b < 8; b++)
+					{
+						hash ^= (value >> (b * 8)) & 0xFF;
+						hash *= 1099511628211ull;
+					}
+				};
+
+				combine(reinterpret_cast<ullong>(layout));
+
+				for (const DescriptorWrite& write : writes)
+				{
+					combine(write.binding);
+					combine(write.type);
+					combine(reinterpret_cast<ullong>(write.buffer));
+					combine(write.offset);
+					combine(write.range);
+					combine(reinterpret_cast<ullong>(write.imageView));
+					combine(reinterpret_cast<ullong>(write.sampler));
+					combine(write.imageLayout);
+				}
+
+				return hash;
+			}
+
+			Mutex mutex;
+
+			Unique<DescriptorAllocator> allocator;
+			UnorderedMap<ullong, Vector<Entry>> descriptorSets;
+
+			Size hitCount = 0;
+
+		};
+	}
+}
@@ -0,0 +1,392 @@
+#pragma once
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+using namespace RenderVulkan::Core;
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		enum class DeviceFeature
+		{
+			TIMELINE_SEMAPHORE,
+			SYNCHRONIZATION_2,
+			DYNAMIC_RENDERING,
+			DESCRIPTOR_INDEXING,
+			BUFFER_DEVICE_ADDRESS,
+			EXTENDED_DYNAMIC_STATE,
+			EXTENDED_DYNAMIC_STATE_3,
+			SAMPLER_ANISOTROPY,
+			SAMPLE_RATE_SHADING,
+			GRAPHICS_PIPELINE_LIBRARY
+		};
+
+		class DeviceCapabilities
+		{
+
+		public:
+
+			DeviceCapabilities() = default;
+
+			DeviceCapabilities(const DeviceCapabilities& other)
+			{
+				*this = other;
+			}
+
+			DeviceCapabilities& operator=(const DeviceCapabilities& other)
+			{
+				apiVersion = other.apiVersion;
+				availableExtensions = other.availableExtensions;
+				supportedFeatures = other.supportedFeatures;
+				deviceName = other.deviceName;
+
+				return *this;
+			}
+
+			bool IsSupported(DeviceFeature feature) const
+			{
+				return supportedFeatures.contains(feature);
+			}
+
+			bool HasExtension(const String& extension) const
+			{
+				return availableExtensions.contains(extension);
+			}
+
+			uint GetApiVersion() const
+			{
+				return apiVersion;
+			}
+
+			bool IsApiVersionAtLeast(uint version) const
+			{
+				return apiVersion >= version;
+			}
+
+			const String& GetDeviceName() const
+			{
+				return deviceName;
+			}
+
+			bool MeetsRequirements() const
+			{
+				return IsApiVersionAtLeast(VK_API_VERSION_1_2) && IsSupported(DeviceFeature::TIMELINE_SEMAPHORE);
+			}
+
+			Vector<const char*> GetRequiredExtensions() const
+			{
+				Vector<const char*> extensions;
+
+				if (!IsApiVersionAtLeast(VK_API_VERSION_1_3))
+				{
+					if (IsSupported(DeviceFeature::SYNCHRONIZATION_2))
+						extensions.push_back(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+
+					if (IsSupported(DeviceFeature::DYNAMIC_RENDERING))
+						extensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+
+					if (IsSupported(DeviceFeature::EXTENDED_DYNAMIC_STATE))
+						extensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+				}
+
+				if (IsSupported(DeviceFeature::EXTENDED_DYNAMIC_STATE_3))
+					extensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
+
+				if (IsSupported(DeviceFeature::GRAPHICS_PIPELINE_LIBRARY))
+				{
+					extensions.push_back(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+					extensions.push_back(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+				}
+
+				return extensions;
+			}
+
+			const VkPhysicalDeviceFeatures2* BuildFeatureChain()
+			{
+				enabledFeatures = {};
+				enabledVulkan12Features = {};
+				enabledVulkan13Features = {};
+				enabledSynchronization2Features = {};
+				enabledDynamicRenderingFeatures = {};
+				enabledExtendedDynamicStateFeatures = {};
+				enabledExtendedDynamicState3Features = {};
+				enabledGraphicsPipelineLibraryFeatures = {};
+
+				enabledFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+				enabledFeatures.features.samplerAnisotropy = IsSupported(DeviceFeature::SAMPLER_ANISOTROPY);
+				enabledFeatures.features.sampleRateShading = IsSupported(DeviceFeature::SAMPLE_RATE_SHADING);
+				enabledFeatures.features.shaderStorageBufferArrayDynamicIndexing = IsSupported(DeviceFeature::DESCRIPTOR_INDEXING);
+
+				void** next = &enabledFeatures.pNext;
+
+				enabledVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+				enabledVulkan12Features.timelineSemaphore = IsSupported(DeviceFeature::TIMELINE_SEMAPHORE);
+				enabledVulkan12Features.bufferDeviceAddress = IsSupported(DeviceFeature::BUFFER_DEVICE_ADDRESS);
+
+				if (IsSupported(DeviceFeature::DESCRIPTOR_INDEXING))
+				{
+					enabledVulkan12Features.descriptorIndexing = VK_TRUE;
+					enabledVulkan12Features.runtimeDescriptorArray = VK_TRUE;
+					enabledVulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+					enabledVulkan12Features.descriptorBindingVariableDescriptorCount = VK_TRUE;
+					enabledVulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+					enabledVulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+					enabledVulkan12Features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+					enabledVulkan12Features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+				}
+
+				*next = &enabledVulkan12Features;
+				next = &enabledVulkan12Features.pNext;
+
+				if (IsApiVersionAtLeast(VK_API_VERSION_1_3))
+				{
+					enabledVulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+					enabledVulkan13Features.synchronization2 = IsSupported(DeviceFeature::SYNCHRONIZATION_2);
+					enabledVulkan13Features.dynamicRendering = IsSupported(DeviceFeature::DYNAMIC_RENDERING);
+
+					*next = &enabledVulkan13Features;
+					next = &enabledVulkan13Features.pNext;
+				}
+				else
+				{
+					if (IsSupported(DeviceFeature::SYNCHRONIZATION_2))
+					{
+						enabledSynchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR;
+						enabledSynchronization2Features.synchronization2 = VK_TRUE;
+
+						*next = &enabledSynchronization2Features;
+						next = &enabledSynchronization2Features.pNext;
+					}
+
+					if (IsSupported(DeviceFeature::DYNAMIC_RENDERING))
+					{
+						enabledDynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+						enabledDynamicRenderingFeatures.dynamicRendering = VK_TRUE;
+
+						*next = &enabledDynamicRenderingFeatures;
+						next = &enabledDynamicRenderingFeatures.pNext;
+					}
+
+					if (IsSupported(DeviceFeature::EXTENDED_DYNAMIC_STATE))
+					{
+						enabledExtendedDynamicStateFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+						enabledExtendedDynamicStateFeatures.extendedDynamicState = VK_TRUE;
+
+						*next = &enabledExtendedDynamicStateFeatures;
+						next = &enabledExtendedDynamicStateFeatures.pNext;
+					}
+				}
+
+				if (IsSupported(DeviceFeature::EXTENDED_DYNAMIC_STATE_3))
+				{
+					enabledExtendedDynamicState3Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+					enabledExtendedDynamicState3Features.extendedDynamicState3ColorBlendEnable = VK_TRUE;
+
+					*next = &enabledExtendedDynamicState3Features;
+					next = &enabledExtendedDynamicState3Features.pNext;
+				}
+
+				if (IsSupported(DeviceFeature::GRAPHICS_PIPELINE_LIBRARY))
+				{
+					enabledGraphicsPipelineLibraryFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+					enabledGraphicsPipelineLibraryFeatures.graphicsPipelineLibrary = VK_TRUE;
+
+					*next = &enabledGraphicsPipelineLibraryFeatures;
+				}
+
+				return &enabledFeatures;
+			}
+
+			void Log() const
+			{
+				Logger_WriteConsole(Formatter::Format("Device '{}' supports Vulkan {}.{}.{}", deviceName, VK_API_VERSION_MAJOR(apiVersion), VK_API_VERSION_MINOR(apiVersion), VK_API_VERSION_PATCH(apiVersion)), LogLevel::INFORMATION);
+
+				for (const auto& [feature, name] : GetFeatureNames())
+					Logger_WriteConsole(Formatter::Format("    {}: {}", name, IsSupported(feature) ? "enabled" : "unavailable"), LogLevel::INFORMATION);
+			}
+
+			static DeviceCapabilities Query(VkPhysicalDevice physicalDevice, uint instanceApiVersion)
+			{
+				DeviceCapabilities capabilities;
+
+				VkPhysicalDeviceProperties properties;
+				vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+				capabilities.deviceName = properties.deviceName;
+				capabilities.apiVersion = std::min(properties.apiVersion, instanceApiVersion);
+
+				uint extensionCount = 0;
+				vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+
+				Vector<VkExtensionProperties> extensions(extensionCount);
+				vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, extensions.data());
+
+				for (const auto& extension : extensions)
+					capabilities.availableExtensions.insert(extension.extensionName);
+
+				if (!capabilities.IsApiVersionAtLeast(VK_API_VERSION_1_1))
+				{
+					VkPhysicalDeviceFeatures features;
+					vkGetPhysicalDeviceFeatures(physicalDevice, &features);
+
+					capabilities.AddIf(DeviceFeature::SAMPLER_ANISOTROPY, features.samplerAnisotropy);
+					capabilities.AddIf(DeviceFeature::SAMPLE_RATE_SHADING, features.sampleRateShading);
+
+					return capabilities;
+				}
+
+				VkPhysicalDeviceFeatures2 features{};
+				VkPhysicalDeviceVulkan12Features vulkan12Features{};
+				VkPhysicalDeviceVulkan13Features vulkan13Features{};
+				VkPhysicalDeviceSynchronization2FeaturesKHR synchronization2Features{};
+				VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures{};
+				VkPhysicalDeviceExtendedDynamicStateFeaturesEXT extendedDynamicStateFeatures{};
+				VkPhysicalDeviceExtendedDynamicState3FeaturesEXT extendedDynamicState3Features{};
+				VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT graphicsPipelineLibraryFeatures{};
+
+				features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+				vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+				vulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+				synchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR;
+				dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+				extendedDynamicStateFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+				extendedDynamicState3Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+				graphicsPipelineLibraryFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+
+				void** next = &features.pNext;
+
+				if (capabilities.IsApiVersionAtLeast(VK_API_VERSION_1_2))
+				{
+					*next = &vulkan12Features;
+					next = &vulkan12Features.pNext;
+				}
+
+				if (capabilities.IsApiVersionAtLeast(VK_API_VERSION_1_3))
+				{
+					*next = &vulkan13Features;
+					next = &vulkan13Features.pNext;
+				}
+				else
+				{
+					if (capabilities.HasExtension(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME))
+					{
+						*next = &synchronization2Features;
+						next = &synchronization2Features.pNext;
+					}
+
+					if (capabilities.HasExtension(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME))
+					{
+						*next = &dynamicRenderingFeatures;
+						next = &dynamicRenderingFeatures.pNext;
+					}
+
+					if (capabilities.HasExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME))
+					{
+						*next = &extendedDynamicStateFeatures;
+						next = &extendedDynamicStateFeatures.pNext;
+					}
+				}
+
+				bool hasExtendedDynamicState3 = capabilities.HasExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
+
+				if (hasExtendedDynamicState3)
+				{
+					*next = &extendedDynamicState3Features;
+					next = &extendedDynamicState3Features.pNext;
+				}
+
+				bool hasPipelineLibraries = capabilities.HasExtension(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME) && capabilities.HasExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+
+				if (hasPipelineLibraries)
+					*next = &graphicsPipelineLibraryFeatures;
+
+				vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+				capabilities.AddIf(DeviceFeature::SAMPLER_ANISOTROPY, features.features.samplerAnisotropy);
+				capabilities.AddIf(DeviceFeature::SAMPLE_RATE_SHADING, features.features.sampleRateShading);
+
+				capabilities.AddIf(DeviceFeature::TIMELINE_SEMAPHORE, vulkan12Features.timelineSemaphore);
+				capabilities.AddIf(DeviceFeature::BUFFER_DEVICE_ADDRESS, vulkan12Features.bufferDeviceAddress);
+				capabilities.AddIf(DeviceFeature::DESCRIPTOR_INDEXING, features.features.shaderStorageBufferArrayDynamicIndexing && vulkan12Features.descriptorIndexing && vulkan12Features.runtimeDescriptorArray && vulkan12Features.descriptorBindingPartiallyBound && vulkan12Features.descriptorBindingVariableDescriptorCount && vulkan12Features.shaderSampledImageArrayNonUniformIndexing && vulkan12Features.descriptorBindingSampledImageUpdateAfterBind && vulkan12Features.descriptorBindingStorageBufferUpdateAfterBind && vulkan12Features.descriptorBindingUpdateUnusedWhilePending);
+
+				if (capabilities.IsApiVersionAtLeast(VK_API_VERSION_1_3))
+				{
+					capabilities.AddIf(DeviceFeature::SYNCHRONIZATION_2, vulkan13Features.synchronization2);
+					capabilities.AddIf(DeviceFeature::DYNAMIC_RENDERING, vulkan13Features.dynamicRendering);
+					capabilities.AddIf(DeviceFeature::EXTENDED_DYNAMIC_STATE, true);
+				}
+				else
+				{
+					capabilities.AddIf(DeviceFeature::SYNCHRONIZATION_2, synchronization2Features.synchronization2);
+					capabilities.AddIf(DeviceFeature::DYNAMIC_RENDERING, dynamicRenderingFeatures.dynamicRendering);
+					capabilities.AddIf(DeviceFeature::EXTENDED_DYNAMIC_STATE, extendedDynamicStateFeatures.extendedDynamicState);
+				}
+
+				capabilities.AddIf(DeviceFeature::EXTENDED_DYNAMIC_STATE_3, hasExtendedDynamicState3 && extendedDynamicState3Features.extendedDynamicState3ColorBlendEnable);
+				capabilities.AddIf(DeviceFeature::GRAPHICS_PIPELINE_LIBRARY, hasPipelineLibraries && graphicsPipelineLibraryFeatures.graphicsPipelineLibrary);
+
+				return capabilities;
+			}
+
+			static uint GetInstanceApiVersion()
+			{
+				uint version = VK_API_VERSION_1_0;
+
+				auto function = (PFN_vkEnumerateInstanceVersion)vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceVersion");
+
+				if (function != nullptr)
+					function(&version);
+
+				return std::min(version, static_cast<uint>(VK_API_VERSION_1_3));
+			}
+
+			static const Vector<Pair<DeviceFeature, String>>& GetFeatureNames()
+			{
+				static const Vector<Pair<DeviceFeature, String>> names =
+				{
+					{ DeviceFeature::TIMELINE_SEMAPHORE, "Timeline semaphores" },
+					{ DeviceFeature::SYNCHRONIZATION_2, "Synchronization2" },
+					{ DeviceFeature::DYNAMIC_RENDERING, "Dynamic rendering" },
+					{ DeviceFeature::DESCRIPTOR_INDEXING, "Descriptor indexing" },
+					{ DeviceFeature::BUFFER_DEVICE_ADDRESS, "Buffer device address" },
+					{ DeviceFeature::EXTENDED_DYNAMIC_STATE, "Extended dynamic state" },
+					{ DeviceFeature::EXTENDED_DYNAMIC_STATE_3, "Extended dynamic state 3" },
+					{ DeviceFeature::SAMPLER_ANISOTROPY, "Sampler anisotropy" },
+					{ DeviceFeature::SAMPLE_RATE_SHADING, "Sample rate shading" },
+					{ DeviceFeature::GRAPHICS_PIPELINE_LIBRARY, "Graphics pipeline library" }
+				};
+
+				return names;
+			}
+
+		private:
+
+			void AddIf(DeviceFeature feature, bool supported)
+			{
+				if (supported)
+					supportedFeatures.insert(feature);
+			}
+
+			uint apiVersion = VK_API_VERSION_1_0;
+			String deviceName;
+
+			Set<String> availableExtensions;
+			Set<DeviceFeature> supportedFeatures;
+
+			VkPhysicalDeviceFeatures2 enabledFeatures{};
+			VkPhysicalDeviceVulkan12Features enabledVulkan12Features{};
+			VkPhysicalDeviceVulkan13Features enabledVulkan13Features{};
+			VkPhysicalDeviceSynchronization2FeaturesKHR enabledSynchronization2Features{};
+			VkPhysicalDeviceDynamicRenderingFeaturesKHR enabledDynamicRenderingFeatures{};
+			VkPhysicalDeviceExtendedDynamicStateFeaturesEXT enabledExtendedDynamicStateFeatures{};
+			VkPhysicalDeviceExtendedDynamicState3FeaturesEXT enabledExtendedDynamicState3Features{};
+			VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT enabledGraphicsPipelineLibraryFeatures{};
+
+		};
+	}
+}
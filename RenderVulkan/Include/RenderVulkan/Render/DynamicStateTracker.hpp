@@ -0,0 +1,276 @@
+#pragma once
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Core/Settings.hpp"
+#include "RenderVulkan/Render/DeviceCapabilities.hpp"
+#include "RenderVulkan/Render/PipelineStateCache.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+using namespace RenderVulkan::Core;
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		struct PipelineDynamicState
+		{
+			VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+			VkFrontFace frontFace = VK_FRONT_FACE_CLOCKWISE;
+			VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+			bool depthTest = true;
+			bool depthWrite = true;
+			VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS;
+
+			bool blendEnable = false;
+			uint colorAttachmentCount = 1;
+		};
+
+		class DynamicStateTracker
+		{
+
+		public:
+
+			DynamicStateTracker(const DynamicStateTracker&) = delete;
+			DynamicStateTracker& operator=(const DynamicStateTracker&) = delete;
+
+			void Initialize()
+			{
+				VkDevice device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
+				DeviceCapabilities capabilities = Settings::GetInstance()->Get<DeviceCapabilities>("deviceCapabilities");
+
+				isRasterStateDynamic = false;
+				isBlendEnableDynamic = false;
+
+				if (Settings::GetInstance()->Get<bool>("staticPipelineState") || !capabilities.IsSupported(DeviceFeature::EXTENDED_DYNAMIC_STATE))
+					return;
+
+				setCullMode = LoadFunction<PFN_vkCmdSetCullModeEXT>(device, "vkCmdSetCullMode");
+				setFrontFace = LoadFunction<PFN_vkCmdSetFrontFaceEXT>(device, "vkCmdSetFrontFace");
+				setPrimitiveTopology = LoadFunction<PFN_vkCmdSetPrimitiveTopologyEXT>(device, "vkCmdSetPrimitiveTopology");
+				setDepthTestEnable = LoadFunction<PFN_vkCmdSetDepthTestEnableEXT>(device, "vkCmdSetDepthTestEnable");
+				setDepthWriteEnable = LoadFunction<PFN_vkCmdSetDepthWriteEnableEXT>(device, "vkCmdSetDepthWriteEnable");
+				setDepthCompareOp = LoadFunction<PFN_vkCmdSetDepthCompareOpEXT>(device, "vkCmdSetDepthCompareOp");
+
+				isRasterStateDynamic = setCullMode && setFrontFace && setPrimitiveTopology && setDepthTestEnable && setDepthWriteEnable && setDepthCompareOp;
+
+				if (!isRasterStateDynamic)
+				{
+					Logger_WriteConsole("Extended dynamic state entry points are missing, baking raster state into pipelines", LogLevel::WARNING);
+					return;
+				}
+
+				if (capabilities.IsSupported(DeviceFeature::EXTENDED_DYNAMIC_STATE_3))
+				{
+					setColorBlendEnable = reinterpret_cast<PFN_vkCmdSetColorBlendEnableEXT>(vkGetDeviceProcAddr(device, "vkCmdSetColorBlendEnableEXT"));
+					isBlendEnableDynamic = setColorBlendEnable != nullptr;
+				}
+
+				Logger_WriteConsole(Formatter::Format("Dynamic pipeline state enabled (blend enable {})", isBlendEnableDynamic ? "dynamic" : "baked"), LogLevel::INFORMATION);
+			}
+
+			bool IsEnabled() const
+			{
+				return isRasterStateDynamic;
+			}
+
+			PipelineDynamicState Normalize(PipelineStateKey& key) const
+			{
+				PipelineDynamicState state;
+
+				state.cullMode = key.cullMode;
+				state.frontFace = key.frontFace;
+				state.topology = key.topology;
+				state.depthTest = key.depthTest;
+				state.depthWrite = key.depthWrite;
+				state.depthCompareOp = key.depthCompareOp;
+				state.blendEnable = key.blendMode != BlendMode::DISABLED;
+				state.colorAttachmentCount = key.colorAttachmentCount;
+
+				if (!isRasterStateDynamic)
+					return state;
+
+				PipelineStateKey defaults;
+
+				key.cullMode = defaults.cullMode;
+				key.frontFace = defaults.frontFace;
+				key.topology = GetTopologyClass(key.topology);
+				key.depthTest = defaults.depthTest;
+				key.depthWrite = defaults.depthWrite;
+				key.depthCompareOp = defaults.depthCompareOp;
+				key.hasDynamicRasterState = true;
+
+				if (isBlendEnableDynamic)
+				{
+					if (key.blendMode == BlendMode::DISABLED)
+						key.blendMode = BlendMode::ALPHA;
+
+					key.hasDynamicBlendEnable = true;
+				}
+
+				return state;
+			}
+
+			void Begin(VkCommandBuffer commandBuffer)
+			{
+				RecordingState& recording = GetRecordingState();
+
+				recording = {};
+				recording.commandBuffer = commandBuffer;
+			}
+
+			void Apply(VkCommandBuffer commandBuffer, const PipelineDynamicState& state)
+			{
+				if (!isRasterStateDynamic)
+					return;
+
+				RecordingState& recording = GetRecordingState();
+
+				if (recording.commandBuffer != commandBuffer)
+					Begin(commandBuffer);
+
+				const PipelineDynamicState& current = recording.state;
+				bool isValid = recording.isValid;
+				Size emitted = 0;
+
+				if (!isValid || current.cullMode != state.cullMode)
+				{
+					setCullMode(commandBuffer, state.cullMode);
+					emitted++;
+				}
+
+				if (!isValid || current.frontFace != state.frontFace)
+				{
+					setFrontFace(commandBuffer, state.frontFace);
+					emitted++;
+				}
+
+				if (!isValid || current.topology != state.topology)
+				{
+					setPrimitiveTopology(commandBuffer, state.topology);
+					emitted++;
+				}
+
+				if (!isValid || current.depthTest != state.depthTest)
+				{
+					setDepthTestEnable(commandBuffer, state.depthTest ? VK_TRUE : VK_FALSE);
+					emitted++;
+				}
+
+				if (!isValid || current.depthWrite != state.depthWrite)
+				{
+					setDepthWriteEnable(commandBuffer, state.depthWrite ? VK_TRUE : VK_FALSE);
+					emitted++;
+				}
+
+				if (!isValid || current.depthCompareOp != state.depthCompareOp)
+				{
+					setDepthCompareOp(commandBuffer, state.depthCompareOp);
+					emitted++;
+				}
+
+				if (isBlendEnableDynamic && state.colorAttachmentCount > 0 && (!isValid || current.blendEnable != state.blendEnable || current.colorAttachmentCount != state.colorAttachmentCount))
+				{
+					Vector<VkBool32> enables(state.colorAttachmentCount, state.blendEnable ? VK_TRUE : VK_FALSE);
+
+					setColorBlendEnable(commandBuffer, 0, static_cast<uint>(enables.size()), enables.data());
+					emitted++;
+				}
+
+				recording.state = state;
+				recording.isValid = true;
+
+				emittedCount += emitted;
+				skippedCount += (isBlendEnableDynamic ? 7 : 6) - emitted;
+			}
+
+			Size GetEmittedCount() const
+			{
+				return emittedCount;
+			}
+
+			Size GetSkippedCount() const
+			{
+				return skippedCount;
+			}
+
+			static Shared<DynamicStateTracker> GetInstance()
+			{
+				class EnabledDynamicStateTracker : public DynamicStateTracker { };
+
+				static Shared<DynamicStateTracker> instance = std::make_shared<EnabledDynamicStateTracker>();
+
+				return instance;
+			}
+
+		private:
+
+			struct RecordingState
+			{
+				VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+				PipelineDynamicState state;
+				bool isValid = false;
+			};
+
+			DynamicStateTracker() = default;
+
+			static RecordingState& GetRecordingState()
+			{
+				thread_local RecordingState recording;
+
+				return recording;
+			}
+
+			template<typename T>
+			static T LoadFunction(VkDevice device, const String& name)
+			{
+				PFN_vkVoidFunction function = vkGetDeviceProcAddr(device, name.c_str());
+
+				if (function == nullptr)
+					function = vkGetDeviceProcAddr(device, (name + "EXT").c_str());
+
+				return reinterpret_cast<T>(function);
+			}
+
+			static VkPrimitiveTopology GetTopologyClass(VkPrimitiveTopology topology)
+			{
+				switch (topology)
+				{
+
+				case VK_PRIMITIVE_TOPOLOGY_POINT_LIST:
+					return VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
+
+				case VK_PRIMITIVE_TOPOLOGY_LINE_LIST:
+				case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP:
+				case VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY:
+				case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY:
+					return VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+
+				case VK_PRIMITIVE_TOPOLOGY_PATCH_LIST:
+					return VK_PRIMITIVE_TOPOLOGY_PATCH_LIST;
+
+				default:
+					return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+				}
+			}
+
+			bool isRasterStateDynamic = false;
+			bool isBlendEnableDynamic = false;
+
+			PFN_vkCmdSetCullModeEXT setCullMode = nullptr;
+			PFN_vkCmdSetFrontFaceEXT setFrontFace = nullptr;
+			PFN_vkCmdSetPrimitiveTopologyEXT setPrimitiveTopology = nullptr;
+			PFN_vkCmdSetDepthTestEnableEXT setDepthTestEnable = nullptr;
+			PFN_vkCmdSetDepthWriteEnableEXT setDepthWriteEnable = nullptr;
+			PFN_vkCmdSetDepthCompareOpEXT setDepthCompareOp = nullptr;
+			PFN_vkCmdSetColorBlendEnableEXT setColorBlendEnable = nullptr;
+
+			Atomic<Size> emittedCount = 0;
+			Atomic<Size> skippedCount = 0;
+
+		};
+	}
+}
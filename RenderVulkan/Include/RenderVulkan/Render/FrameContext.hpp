@@ -0,0 +1,62 @@
+#pragma once
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Render/ChangeTracker.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+using namespace RenderVulkan::Core;
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		struct FrameContext
+		{
+			VkCommandPool commandPool = VK_NULL_HANDLE;
+			VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+
+			Vector<VkCommandBuffer> imageCommandBuffers;
+			Vector<ullong> imageRevisions;
+			ullong recordedRevision = ChangeTracker::NO_REVISION;
+
+			Vector<VkCommandPool> workerCommandPools;
+			Vector<Vector<VkCommandBuffer>> secondaryCommandBuffers;
+
+			VkSemaphore imageAvailableSemaphore = VK_NULL_HANDLE;
+			VkSemaphore renderFinishedSemaphore = VK_NULL_HANDLE;
+			ullong timelineValue = 0;
+
+			Vector<Byte> scratchMemory;
+			Size scratchOffset = 0;
+
+			void* AllocateScratch(Size size, Size alignment = alignof(std::max_align_t))
+			{
+				Size offset = (scratchOffset + alignment - 1) & ~(alignment - 1);
+
+				if (offset + size > scratchMemory.size())
+				{
+					Logger_WriteConsole(Formatter::Format("Frame scratch memory exhausted; requested '{}' bytes with '{}' of '{}' in use", size, scratchOffset, scratchMemory.size()), LogLevel::ERROR);
+					return nullptr;
+				}
+
+				scratchOffset = offset + size;
+
+				return scratchMemory.data() + offset;
+			}
+
+			template<typename T>
+			T* AllocateScratch(Size count = 1)
+			{
+				return static_cast<T*>(AllocateScratch(sizeof(T) * count, alignof(T)));
+			}
+
+			void ResetScratch()
+			{
+				scratchOffset = 0;
+			}
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,343 @@
+#pragma once
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Core/Settings.hpp"
+#include "RenderVulkan/Render/PhysicalDeviceDatabase.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+using namespace RenderVulkan::Core;
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		struct GpuZoneResult
+		{
+			String name;
+			double milliseconds = 0.0;
+		};
+
+		class GpuProfiler
+		{
+
+		public:
+
+			GpuProfiler(const GpuProfiler&) = delete;
+			GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+			void Initialize(Size framesInFlight)
+			{
+				device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
+
+				if (!Settings::GetInstance()->Get<bool>("gpuProfiling"))
+					return;
+
+				VkPhysicalDevice physicalDevice = Settings::GetInstance()->GetPointer<VkPhysicalDevice>("physicalDevice");
+				uint graphicsQueueFamily = Settings::GetInstance()->Get<uint>("graphicsQueueFamily");
+
+				const PhysicalDeviceInformation& information = PhysicalDeviceDatabase::GetInstance()->Get(physicalDevice);
+
+				uint validBits = information.queueFamilies[graphicsQueueFamily].timestampValidBits;
+
+				if (validBits == 0 || information.properties.limits.timestampPeriod <= 0.0f)
+				{
+					Logger_WriteConsole("Graphics queue does not support timestamps, GPU profiling disabled", LogLevel::WARNING);
+					return;
+				}
+
+				timestampMask = validBits >= 64 ? NumericLimits<ullong>::max() : (1ull << validBits) - 1;
+				timestampPeriod = information.properties.limits.timestampPeriod;
+
+				frames.resize(framesInFlight);
+
+				for (ProfiledFrame& frame : frames)
+				{
+					VkQueryPoolCreateInfo poolInformation{};
+
+					poolInformation.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+					poolInformation.queryType = VK_QUERY_TYPE_TIMESTAMP;
+					poolInformation.queryCount = MAX_IMAGE_REGIONS * QUERIES_PER_REGION;
+
+					VkResult result = vkCreateQueryPool(device, &poolInformation, nullptr, &frame.queryPool);
+					Logger_ThrowIfFailed(result, "Failed to create timestamp query pool", true);
+				}
+
+				isEnabled = true;
+
+				Logger_WriteConsole("GPU profiler created", LogLevel::INFORMATION);
+			}
+
+			void BeginRecording(Size frameIndex, uint imageIndex, VkCommandBuffer commandBuffer)
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				recordingRegion = nullptr;
+
+				if (!isEnabled || imageIndex >= MAX_IMAGE_REGIONS)
+					return;
+
+				ProfiledFrame& frame = frames[frameIndex];
+
+				recordingRegion = &frame.regions[imageIndex];
+				recordingRegion->zones.clear();
+				recordingRegion->firstQuery = imageIndex * QUERIES_PER_REGION;
+				recordingRegion->usedQueries = 0;
+				recordingPool = frame.queryPool;
+
+				vkCmdResetQueryPool(commandBuffer, frame.queryPool, recordingRegion->firstQuery, QUERIES_PER_REGION);
+			}
+
+			uint BeginZone(VkCommandBuffer commandBuffer, const String& name)
+			{
+				uint query;
+				uint zone;
+
+				{
+					LockGuard<Mutex> lock(mutex);
+
+					if (recordingRegion == nullptr || recordingRegion->usedQueries + 2 > QUERIES_PER_REGION)
+						return INVALID_ZONE;
+
+					query = recordingRegion->firstQuery + recordingRegion->usedQueries;
+					zone = static_cast<uint>(recordingRegion->zones.size());
+
+					recordingRegion->zones.push_back({ name, query, query + 1 });
+					recordingRegion->usedQueries += 2;
+				}
+
+				vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, recordingPool, query);
+
+				return zone;
+			}
+
+			void EndZone(VkCommandBuffer commandBuffer, uint zone)
+			{
+				if (zone == INVALID_ZONE)
+					return;
+
+				uint query;
+
+				{
+					LockGuard<Mutex> lock(mutex);
+
+					if (recordingRegion == nullptr)
+						return;
+
+					query = recordingRegion->zones[zone].endQuery;
+				}
+
+				vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, recordingPool, query);
+			}
+
+			void MarkSubmitted(Size frameIndex, uint imageIndex)
+			{
+				if (!isEnabled || imageIndex >= MAX_IMAGE_REGIONS)
+					return;
+
+				frames[frameIndex].submittedRegion = imageIndex;
+			}
+
+			void Resolve(Size frameIndex)
+			{
+				if (!isEnabled)
+					return;
+
+				ProfiledFrame& frame = frames[frameIndex];
+
+				if (!frame.submittedRegion.has_value())
+					return;
+
+				const ProfiledRegion& region = frame.regions[frame.submittedRegion.value()];
+
+				frame.submittedRegion.reset();
+
+				if (region.usedQueries == 0)
+					return;
+
+				Vector<ullong> timestamps(region.usedQueries);
+
+				VkResult result = vkGetQueryPoolResults(device, frame.queryPool, region.firstQuery, region.usedQueries, timestamps.size() * sizeof(ullong), timestamps.data(), sizeof(ullong), VK_QUERY_RESULT_64_BIT);
+
+				if (result != VK_SUCCESS)
+					return;
+
+				Map<String, double> frameResults;
+
+				for (const ProfiledZone& zone : region.zones)
+				{
+					ullong start = timestamps[zone.startQuery - region.firstQuery] & timestampMask;
+					ullong end = timestamps[zone.endQuery - region.firstQuery] & timestampMask;
+
+					frameResults[zone.name] += end >= start ? static_cast<double>(end - start) * timestampPeriod / 1000000.0 : 0.0;
+				}
+
+				LockGuard<Mutex> lock(mutex);
+
+				latestResults.clear();
+
+				for (const auto& [name, milliseconds] : frameResults)
+				{
+					latestResults.push_back({ name, milliseconds });
+
+					ZoneHistory& history = histories[name];
+
+					if (history.samples.size() < HISTORY_LENGTH)
+						history.samples.push_back(milliseconds);
+					else
+						history.samples[history.next] = milliseconds;
+
+					history.next = (history.next + 1) % HISTORY_LENGTH;
+				}
+			}
+
+			Vector<GpuZoneResult> GetResults()
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				return latestResults;
+			}
+
+			Vector<double> GetHistory(const String& name)
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				if (!histories.contains(name))
+					return {};
+
+				const ZoneHistory& history = histories.at(name);
+
+				if (history.samples.size() < HISTORY_LENGTH)
+					return history.samples;
+
+				Vector<double> ordered;
+
+				ordered.reserve(HISTORY_LENGTH);
+				ordered.insert(ordered.end(), history.samples.begin() + history.next, history.samples.end());
+				ordered.insert(ordered.end(), history.samples.begin(), history.samples.begin() + history.next);
+
+				return ordered;
+			}
+
+			double GetAverage(const String& name)
+			{
+				Vector<double> history = GetHistory(name);
+
+				if (history.empty())
+					return 0.0;
+
+				return std::accumulate(history.begin(), history.end(), 0.0) / static_cast<double>(history.size());
+			}
+
+			bool IsEnabled() const
+			{
+				return isEnabled;
+			}
+
+			void CleanUp()
+			{
+				for (ProfiledFrame& frame : frames)
+				{
+					if (frame.queryPool != VK_NULL_HANDLE)
+						vkDestroyQueryPool(device, frame.queryPool, nullptr);
+				}
+
+				frames.clear();
+				histories.clear();
+				latestResults.clear();
+
+				recordingRegion = nullptr;
+				isEnabled = false;
+			}
+
+			static Shared<GpuProfiler> GetInstance()
+			{
+				class EnabledGpuProfiler : public GpuProfiler { };
+
+				static Shared<GpuProfiler> instance = std::make_shared<EnabledGpuProfiler>();
+
+				return instance;
+			}
+
+			static constexpr uint INVALID_ZONE = NumericLimits<uint>::max();
+			static constexpr uint MAX_IMAGE_REGIONS = 8;
+			static constexpr uint QUERIES_PER_REGION = 256;
+			static constexpr Size HISTORY_LENGTH = 120;
+
+		private:
+
+			struct ProfiledZone
+			{
+				String name;
+				uint startQuery;
+				uint endQuery;
+			};
+
+			struct ProfiledRegion
+			{
+				Vector<ProfiledZone> zones;
+				uint firstQuery = 0;
+				uint usedQueries = 0;
+			};
+
+			struct ProfiledFrame
+			{
+				VkQueryPool queryPool = VK_NULL_HANDLE;
+				Array<ProfiledRegion, MAX_IMAGE_REGIONS> regions;
+				Optional<uint> submittedRegion;
+			};
+
+			struct ZoneHistory
+			{
+				Vector<double> samples;
+				Size next = 0;
+			};
+
+			GpuProfiler() = default;
+
+			VkDevice device = VK_NULL_HANDLE;
+
+			bool isEnabled = false;
+			ullong timestampMask = 0;
+			float timestampPeriod = 0.0f;
+
+			Vector<ProfiledFrame> frames;
+
+			ProfiledRegion* recordingRegion = nullptr;
+			VkQueryPool recordingPool = VK_NULL_HANDLE;
+
+			Mutex mutex;
+
+			Vector<GpuZoneResult> latestResults;
+			UnorderedMap<String, ZoneHistory> histories;
+
+		};
+
+		class GpuZone
+		{
+
+		public:
+
+			GpuZone(VkCommandBuffer commandBuffer, const String& name) : commandBuffer(commandBuffer)
+			{
+				zone = GpuProfiler::GetInstance()->BeginZone(commandBuffer, name);
+			}
+
+			~GpuZone()
+			{
+				GpuProfiler::GetInstance()->EndZone(commandBuffer, zone);
+			}
+
+			GpuZone(const GpuZone&) = delete;
+			GpuZone& operator=(const GpuZone&) = delete;
+
+		private:
+
+			VkCommandBuffer commandBuffer;
+			uint zone;
+
+		};
+	}
+}
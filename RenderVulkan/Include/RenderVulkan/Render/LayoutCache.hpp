@@ -0,0 +1,230 @@
+#pragma once
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Core/Settings.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+using namespace RenderVulkan::Core;
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		class LayoutCache
+		{
+
+		public:
+
+			LayoutCache(const LayoutCache&) = delete;
+			LayoutCache& operator=(const LayoutCache&) = delete;
+
+			VkDescriptorSetLayout GetDescriptorSetLayout(Vector<VkDescriptorSetLayoutBinding> bindings)
+			{
+				std::sort(bindings.begin(), bindings.end(), [](const VkDescriptorSetLayoutBinding& left, const VkDescriptorSetLayoutBinding& right) { return left.binding < right.binding; });
+
+				ullong hash = HashBindings(bindings);
+
+				LockGuard<Mutex> lock(mutex);
+
+				for (const DescriptorSetLayoutEntry& entry : descriptorSetLayouts[hash])
+				{
+					if (AreEqual(entry.bindings, bindings))
+					{
+						hitCount++;
+						return entry.layout;
+					}
+				}
+
+				VkDescriptorSetLayoutCreateInfo layoutInformation{};
+
+				layoutInformation.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+				layoutInformation.bindingCount = static_cast<uint>(bindings.size());
+				layoutInformation.pBindings = bindings.data();
+
+				VkDescriptorSetLayout layout;
+
+				VkResult result = vkCreateDescriptorSetLayout(Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice"), &layoutInformation, nullptr, &layout);
+				Logger_ThrowIfFailed(result, "Failed to create descriptor set layout", false);
+
+				descriptorSetLayouts[hash].push_back({ bindings, layout });
+
+				return layout;
+			}
+
+			VkPipelineLayout GetPipelineLayout(const Vector<VkDescriptorSetLayout>& setLayouts, const Vector<VkPushConstantRange>& pushConstantRanges)
+			{
+				ullong hash = HashPipelineLayout(setLayouts, pushConstantRanges);
+
+				LockGuard<Mutex> lock(mutex);
+
+				for (const PipelineLayoutEntry& entry : pipelineLayouts[hash])
+				{
+					if (entry.setLayouts == setLayouts && AreEqual(entry.pushConstantRanges, pushConstantRanges))
+					{
+						hitCount++;
+						return entry.layout;
+					}
+				}
+
+				VkPipelineLayoutCreateInfo layoutInformation{};
+
+				layoutInformation.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+				layoutInformation.setLayoutCount = static_cast<uint>(setLayouts.size());
+				layoutInformation.pSetLayouts = setLayouts.data();
+				layoutInformation.pushConstantRangeCount = static_cast<uint>(pushConstantRanges.size());
+				layoutInformation.pPushConstantRanges = pushConstantRanges.data();
+
+				VkPipelineLayout layout;
+
+				VkResult result = vkCreatePipelineLayout(Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice"), &layoutInformation, nullptr, &layout);
+				Logger_ThrowIfFailed(result, "Failed to create pipeline layout", false);
+
+				pipelineLayouts[hash].push_back({ setLayouts, pushConstantRanges, layout });
+
+				return layout;
+			}
+
+			void CleanUp()
+			{
+				VkDevice device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
+
+				LockGuard<Mutex> lock(mutex);
+
+				Size descriptorSetLayoutCount = 0;
+				Size pipelineLayoutCount = 0;
+
+				for (const auto& [hash, bucket] : pipelineLayouts)
+				{
+					for (const PipelineLayoutEntry& entry : bucket)
+					{
+						vkDestroyPipelineLayout(device, entry.layout, nullptr);
+						pipelineLayoutCount++;
+					}
+				}
+
+				for (const auto& [hash, bucket] : descriptorSetLayouts)
+				{
+					for (const DescriptorSetLayoutEntry& entry : bucket)
+					{
+						vkDestroyDescriptorSetLayout(device, entry.layout, nullptr);
+						descriptorSetLayoutCount++;
+					}
+				}
+
+				Logger_WriteConsole(Formatter::Format("Layout cache: '{}' descriptor set layouts, '{}' pipeline layouts, '{}' reuses", descriptorSetLayoutCount, pipelineLayoutCount, hitCount), LogLevel::INFORMATION);
+
+				pipelineLayouts.clear();
+				descriptorSetLayouts.clear();
+
+				hitCount = 0;
+			}
+
+			static Shared<LayoutCache> GetInstance()
+			{
+				class EnabledLayoutCache : public LayoutCache { };
+
+				static Shared<LayoutCache> instance = std::make_shared<EnabledLayoutCache>();
+
+				return instance;
+			}
+
+		private:
+
+			struct DescriptorSetLayoutEntry
+			{
+				Vector<VkDescriptorSetLayoutBinding> bindings;
+				VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+			};
+
+			struct PipelineLayoutEntry
+			{
+				Vector<VkDescriptorSetLayout> setLayouts;
+				Vector<VkPushConstantRange> pushConstantRanges;
+				VkPipelineLayout layout = VK_NULL_HANDLE;
+			};
+
+			LayoutCache() = default;
+
+			static void Combine(ullong& hash, ullong value)
+			{
+				for (int b = 0; b < 8; b++)
+				{
+					hash ^= (value >> (b * 8)) & 0xFF;
+					hash *= 1099511628211ull;
+				}
+			}
+
+			static ullong HashBindings(const Vector<VkDescriptorSetLayoutBinding>& bindings)
+			{
+				ullong hash = 14695981039346656037ull;
+
+				for (const VkDescriptorSetLayoutBinding& binding : bindings)
+				{
+					Combine(hash, binding.binding);
+					Combine(hash, binding.descriptorType);
+					Combine(hash, binding.descriptorCount);
+					Combine(hash, binding.stageFlags);
+					Combine(hash, reinterpret_cast<ullong>(binding.pImmutableSamplers));
+				}
+
+				return hash;
+			}
+
+			static ullong HashPipelineLayout(const Vector<VkDescriptorSetLayout>& setLayouts, const Vector<VkPushConstantRange>& pushConstantRanges)
+			{
+				ullong hash = 14695981039346656037ull;
+
+				for (VkDescriptorSetLayout setLayout : setLayouts)
+					Combine(hash, reinterpret_cast<ullong>(setLayout));
+
+				for (const VkPushConstantRange& range : pushConstantRanges)
+				{
+					Combine(hash, range.stageFlags);
+					Combine(hash, range.offset);
+					Combine(hash, range.size);
+				}
+
+				return hash;
+			}
+
+			static bool AreEqual(const Vector<VkDescriptorSetLayoutBinding>& left, const Vector<VkDescriptorSetLayoutBinding>& right)
+			{
+				if (left.size() != right.size())
+					return false;
+
+				for (Size b = 0; b < left.size(); b++)
+				{
+					if (left[b].binding != right[b].binding || left[b].descriptorType != right[b].descriptorType || left[b].descriptorCount != right[b].descriptorCount || left[b].stageFlags != right[b].stageFlags || left[b].pImmutableSamplers != right[b].pImmutableSamplers)
+						return false;
+				}
+
+				return true;
+			}
+
+			static bool AreEqual(const Vector<VkPushConstantRange>& left, const Vector<VkPushConstantRange>& right)
+			{
+				if (left.size() != right.size())
+					return false;
+
+				for (Size r = 0; r < left.size(); r++)
+				{
+					if (left[r].stageFlags != right[r].stageFlags || left[r].offset != right[r].offset || left[r].size != right[r].size)
+						return false;
+				}
+
+				return true;
+			}
+
+			Mutex mutex;
+
+			UnorderedMap<ullong, Vector<DescriptorSetLayoutEntry>> descriptorSetLayouts;
+			UnorderedMap<ullong, Vector<PipelineLayoutEntry>> pipelineLayouts;
+
+			Size hitCount = 0;
+
+		};
+	}
+}
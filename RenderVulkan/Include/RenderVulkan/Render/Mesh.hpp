@@ -4,7 +4,10 @@
 #include "RenderVulkan/Core/Settings.hpp"
 #include "RenderVulkan/ECS/GameObject.hpp"
 #include "RenderVulkan/Math/Transform.hpp"
+#include "RenderVulkan/Render/BindlessManager.hpp"
 #include "RenderVulkan/Render/Shader.hpp"
+#include "RenderVulkan/Render/TimelineScheduler.hpp"
+#include "RenderVulkan/Render/UploadManager.hpp"
 #include "RenderVulkan/Render/Vertex.hpp"
 #include "RenderVulkan/Util/Typedefs.hpp"
 #include "RenderVulkan/Util/VulkanHelper.hpp"
@@ -23,6 +26,12 @@ namespace RenderVulkan
 			Matrix4x4f worldMatrix;
 		};
 
+		struct BindlessDrawConstants
+		{
+			uint objectIndex;
+			uint frameIndex;
+		};
+
 		class Mesh : public Component
 		{
 
@@ -30,38 +39,23 @@ namespace RenderVulkan
 
 			void Generate()
 			{
-				VkDevice device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
-
 				VkDeviceSize vertexBufferSize = sizeof(vertices[0]) * vertices.size();
 				VkDeviceSize indexBufferSize = sizeof(indices[0]) * indices.size();
 
-				VkBuffer stagingBuffer;
-				VkDeviceMemory stagingBufferMemory;
-
-				CreateBuffer(vertexBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
-				void* data;
-				vkMapMemory(device, stagingBufferMemory, 0, vertexBufferSize, 0, &data);
-				memcpy(data, vertices.data(), (size_t)vertexBufferSize);
-				vkUnmapMemory(device, stagingBufferMemory);
+				VulkanHelper::CreateBuffer(vertexBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vertexBuffer, vertexBufferMemory);
+				UploadManager::GetInstance()->UploadBuffer(vertexBuffer, vertices.data(), vertexBufferSize, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
 
-				CreateBuffer(vertexBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vertexBuffer, vertexBufferMemory);
-				CopyBuffer(stagingBuffer, vertexBuffer, vertexBufferSize);
+				VulkanHelper::CreateBuffer(indexBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, indexBuffer, indexBufferMemory);
+				UploadManager::GetInstance()->UploadBuffer(indexBuffer, indices.data(), indexBufferSize, VK_ACCESS_INDEX_READ_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
 
-				vkDestroyBuffer(device, stagingBuffer, nullptr);
-				vkFreeMemory(device, stagingBufferMemory, nullptr);
-
-				CreateBuffer(indexBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
-				vkMapMemory(device, stagingBufferMemory, 0, indexBufferSize, 0, &data);
-				memcpy(data, indices.data(), (size_t)indexBufferSize);
-				vkUnmapMemory(device, stagingBufferMemory);
-
-				CreateBuffer(indexBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, indexBuffer, indexBufferMemory);
-				CopyBuffer(stagingBuffer, indexBuffer, indexBufferSize);
+				Shared<Shader> shader = gameObject->GetComponent<Shader>();
 
-				vkDestroyBuffer(device, stagingBuffer, nullptr);
-				vkFreeMemory(device, stagingBufferMemory, nullptr);
+				if (shader->IsBindless())
+					CreateObjectBuffer();
+				else if (!shader->HasPushConstants<DefaultMatrixBuffer>())
+					shader->CreateConstantBuffer<DefaultMatrixBuffer>();
 
-				gameObject->GetComponent<Shader>()->CreateConstantBuffer<DefaultMatrixBuffer>();
+				ChangeTracker::GetInstance()->Invalidate();
 			}
 
 			String GetName() const
@@ -80,73 +74,58 @@ namespace RenderVulkan
 
 				shader->Bind(commandBuffer);
 
-				VkExtent2D swapChainExtent = Settings::GetInstance()->Get<VkExtent2D>("swapChainExtent");
-
-				VkViewport viewport{};
-
-				viewport.x = 0.0f;
-				viewport.y = 0.0f;
-				viewport.width = static_cast<float>(swapChainExtent.width);
-				viewport.height = static_cast<float>(swapChainExtent.height);
-				viewport.minDepth = 0.0f;
-				viewport.maxDepth = 1.0f;
-
-				vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
-
-				VkRect2D scissor{};
-
-				scissor.offset = { 0, 0 };
-				scissor.extent = swapChainExtent;
-
-				vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
-
-				VkBuffer vertexBuffers[] = { vertexBuffer };
-				VkDeviceSize offsets[] = { 0 };
-
-				vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+				Draw(commandBuffer, shader);
+			}
 
-				vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+			void RenderDepth(VkCommandBuffer commandBuffer) override
+			{
+				Shared<Shader> shader = gameObject->GetComponent<Shader>();
 
-				shader->UpdateConstantBuffer(DefaultMatrixBuffer
-				{ 
-					glm::transpose(transform->GetWorldMatrix()) 
-				});
+				if (shader->GetDepthPipeline() == VK_NULL_HANDLE)
+					return;
 
-				const auto& descriptorSets = shader->GetDescriptorManager()->GetDescriptorSets();
-				vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shader->GetPipelineLayout(), 0, static_cast<uint>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
+				shader->BindDepth(commandBuffer);
 
-				vkCmdDrawIndexed(commandBuffer, static_cast<uint>(indices.size()), 1, 0, 0, 0);
+				Draw(commandBuffer, shader);
 			}
 
 			void CleanUp() override
 			{
 				VkDevice device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
 
-				vkDeviceWaitIdle(device);
+				UploadManager::GetInstance()->Flush();
 
-				if (indexBuffer != VK_NULL_HANDLE)
-				{
-					vkDestroyBuffer(device, indexBuffer, nullptr);
-					indexBuffer = VK_NULL_HANDLE;
-				}
+				ChangeTracker::GetInstance()->Invalidate();
 
-				if (indexBufferMemory != VK_NULL_HANDLE)
+				if (objectBuffer != VK_NULL_HANDLE)
 				{
-					vkFreeMemory(device, indexBufferMemory, nullptr);
-					indexBufferMemory = VK_NULL_HANDLE;
-				}
+					BindlessManager::GetInstance()->ReleaseBuffer(objectIndex);
 
-				if (vertexBuffer != VK_NULL_HANDLE)
-				{
-					vkDestroyBuffer(device, vertexBuffer, nullptr);
-					vertexBuffer = VK_NULL_HANDLE;
+					vkUnmapMemory(device, objectBufferMemory);
 				}
 
-				if (vertexBufferMemory != VK_NULL_HANDLE)
+				Array<VkBuffer, 3> retiredBuffers = { objectBuffer, indexBuffer, vertexBuffer };
+				Array<VkDeviceMemory, 3> retiredMemory = { objectBufferMemory, indexBufferMemory, vertexBufferMemory };
+
+				TimelineScheduler::GetInstance()->OnLastSubmittedComplete([device, retiredBuffers, retiredMemory]()
 				{
-					vkFreeMemory(device, vertexBufferMemory, nullptr);
-					vertexBufferMemory = VK_NULL_HANDLE;
-				}
+					for (VkBuffer buffer : retiredBuffers)
+						vkDestroyBuffer(device, buffer, nullptr);
+
+					for (VkDeviceMemory memory : retiredMemory)
+						vkFreeMemory(device, memory, nullptr);
+				});
+
+				objectBuffer = VK_NULL_HANDLE;
+				objectBufferMemory = VK_NULL_HANDLE;
+				objectBufferData = nullptr;
+				objectIndex = BindlessManager::INVALID_INDEX;
+
+				indexBuffer = VK_NULL_HANDLE;
+				indexBufferMemory = VK_NULL_HANDLE;
+
+				vertexBuffer = VK_NULL_HANDLE;
+				vertexBufferMemory = VK_NULL_HANDLE;
 			}
 
 			static Shared<Mesh> Create(String name, Vector<Vertex> vertices, Vector<uint> indices)
@@ -168,93 +147,71 @@ namespace RenderVulkan
 
 			Mesh() = default;
 
-			void CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory)
+			void CreateObjectBuffer()
 			{
 				VkDevice device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
 
-				VkBufferCreateInfo bufferInfo{};
+				VkDeviceSize objectBufferSize = sizeof(DefaultMatrixBuffer) * BindlessManager::GetInstance()->GetFramesInFlight();
 
-				bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-				bufferInfo.size = size;
-				bufferInfo.usage = usage;
-				bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+				VulkanHelper::CreateBuffer(objectBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, objectBuffer, objectBufferMemory);
 
-				VkResult result = vkCreateBuffer(device, &bufferInfo, nullptr, &buffer);
-				Logger_ThrowIfFailed(result, "Failed to create buffer!", false);
+				VkResult result = vkMapMemory(device, objectBufferMemory, 0, objectBufferSize, 0, &objectBufferData);
+				Logger_ThrowIfFailed(result, "Failed to map object buffer", false);
 
-				VkMemoryRequirements memRequirements;
-
-				vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
-
-				VkMemoryAllocateInfo allocInfo{};
-
-				allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-				allocInfo.allocationSize = memRequirements.size;
-				allocInfo.memoryTypeIndex = VulkanHelper::FindMemoryType(memRequirements.memoryTypeBits, properties);
-
-				result = vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory);
-				Logger_ThrowIfFailed(result, "Failed to allocate buffer memory!", false);
-
-				vkBindBufferMemory(device, buffer, bufferMemory, 0);
+				objectIndex = BindlessManager::GetInstance()->RegisterBuffer(objectBuffer, objectBufferSize);
 			}
 
-			void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size)
+			void Draw(VkCommandBuffer commandBuffer, const Shared<Shader>& shader)
 			{
-				VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
-
-				VkBufferCopy copyRegion{};
-
-				copyRegion.srcOffset = 0;
-				copyRegion.dstOffset = 0;
-				copyRegion.size = size;
-
-				vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
-
-				EndSingleTimeCommands(commandBuffer);
-			}
-
-			VkCommandBuffer BeginSingleTimeCommands()
-			{
-				VkDevice device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
-				VkCommandPool commandPool = Settings::GetInstance()->GetPointer<VkCommandPool>("commandPool");
+				VkExtent2D swapChainExtent = Settings::GetInstance()->Get<VkExtent2D>("swapChainExtent");
 
-				VkCommandBufferAllocateInfo allocationInformation{};
+				VkViewport viewport{};
 
-				allocationInformation.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-				allocationInformation.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-				allocationInformation.commandPool = commandPool;
-				allocationInformation.commandBufferCount = 1;
+				viewport.x = 0.0f;
+				viewport.y = 0.0f;
+				viewport.width = static_cast<float>(swapChainExtent.width);
+				viewport.height = static_cast<float>(swapChainExtent.height);
+				viewport.minDepth = 0.0f;
+				viewport.maxDepth = 1.0f;
 
-				VkCommandBuffer commandBuffer;
+				vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
 
-				vkAllocateCommandBuffers(device, &allocationInformation, &commandBuffer);
+				VkRect2D scissor{};
 
-				VkCommandBufferBeginInfo beginInfo{};
-				beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-				beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+				scissor.offset = { 0, 0 };
+				scissor.extent = swapChainExtent;
 
-				vkBeginCommandBuffer(commandBuffer, &beginInfo);
+				vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
-				return commandBuffer;
-			}
+				VkBuffer vertexBuffers[] = { vertexBuffer };
+				VkDeviceSize offsets[] = { 0 };
 
-			void EndSingleTimeCommands(VkCommandBuffer commandBuffer)
-			{
-				VkDevice device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
-				VkQueue graphicsQueue = Settings::GetInstance()->GetPointer<VkQueue>("graphicsQueue");
-				VkCommandPool commandPool = Settings::GetInstance()->GetPointer<VkCommandPool>("commandPool");
+				vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
 
-				vkEndCommandBuffer(commandBuffer);
+				vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
 
-				VkSubmitInfo submitInfo{};
-				submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-				submitInfo.commandBufferCount = 1;
-				submitInfo.pCommandBuffers = &commandBuffer;
+				DefaultMatrixBuffer matrixBuffer
+				{ 
+					glm::transpose(transform->GetWorldMatrix()) 
+				};
 
-				vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-				vkQueueWaitIdle(graphicsQueue);
+				if (shader->IsBindless())
+				{
+					BindlessDrawConstants drawConstants
+					{
+						objectIndex,
+						BindlessManager::GetInstance()->GetFrameIndex()
+					};
+
+					std::memcpy(static_cast<DefaultMatrixBuffer*>(objectBufferData) + drawConstants.frameIndex, &matrixBuffer, sizeof(matrixBuffer));
+					shader->PushConstants(commandBuffer, drawConstants);
+				}
+				else if (shader->HasPushConstants<DefaultMatrixBuffer>())
+					shader->PushConstants(commandBuffer, matrixBuffer);
+				else if (!shader->UpdateConstantBuffer(commandBuffer, matrixBuffer))
+					return;
 
-				vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+				vkCmdDrawIndexed(commandBuffer, static_cast<uint>(indices.size()), 1, 0, 0, 0);
 			}
 
 			String name;
@@ -266,6 +223,11 @@ namespace RenderVulkan
 			VkDeviceMemory vertexBufferMemory = VK_NULL_HANDLE;
 			VkBuffer indexBuffer = VK_NULL_HANDLE;
 			VkDeviceMemory indexBufferMemory = VK_NULL_HANDLE;
+
+			VkBuffer objectBuffer = VK_NULL_HANDLE;
+			VkDeviceMemory objectBufferMemory = VK_NULL_HANDLE;
+			void* objectBufferData = nullptr;
+			uint objectIndex = BindlessManager::INVALID_INDEX;
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,285 @@
+#pragma once
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Core/Settings.hpp"
+#include "RenderVulkan/Render/DeviceCapabilities.hpp"
+#include "RenderVulkan/Render/QueueFamilyIndices.hpp"
+#include "RenderVulkan/Render/SwapChainSupportDetails.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+#include "RenderVulkan/Util/VulkanHelper.hpp"
+
+using namespace RenderVulkan::Core;
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		struct PhysicalDeviceInformation
+		{
+			VkPhysicalDevice handle = VK_NULL_HANDLE;
+
+			VkPhysicalDeviceProperties properties{};
+			VkPhysicalDeviceFeatures features{};
+			VkPhysicalDeviceMemoryProperties memoryProperties{};
+
+			Vector<VkQueueFamilyProperties> queueFamilies;
+			QueueFamilyIndices queueFamilyIndices;
+			Optional<uint> dedicatedTransferFamily;
+			Optional<uint> dedicatedComputeFamily;
+
+			SwapChainSupportDetails swapChainSupport{};
+			DeviceCapabilities capabilities;
+
+			VkDeviceSize deviceLocalMemory = 0;
+
+			bool isCompatible = false;
+			String incompatibilityReason;
+			int score = 0;
+		};
+
+		class PhysicalDeviceDatabase
+		{
+
+		public:
+
+			PhysicalDeviceDatabase(const PhysicalDeviceDatabase&) = delete;
+			PhysicalDeviceDatabase& operator=(const PhysicalDeviceDatabase&) = delete;
+
+			void Populate(VkInstance instance, VkSurfaceKHR surface, uint instanceApiVersion, const Vector<const char*>& requiredExtensions)
+			{
+				devices.clear();
+
+				uint deviceCount = 0;
+				vkEnumeratePhysicalDevices(instance, &deviceCount, nullptr);
+
+				if (deviceCount <= 0)
+					Logger_ThrowException("Failed to find GPU(s) with Vulkan support", true);
+
+				Vector<VkPhysicalDevice> handles(deviceCount);
+				vkEnumeratePhysicalDevices(instance, &deviceCount, handles.data());
+
+				for (VkPhysicalDevice handle : handles)
+					devices.push_back(QueryDevice(handle, surface, instanceApiVersion, requiredExtensions));
+
+				for (Size d = 0; d < devices.size(); d++)
+				{
+					const PhysicalDeviceInformation& device = devices[d];
+
+					if (device.isCompatible)
+						Logger_WriteConsole(Formatter::Format("Device [{}] '{}' scored {}", d, device.properties.deviceName, device.score), LogLevel::INFORMATION);
+					else
+						Logger_WriteConsole(Formatter::Format("Device [{}] '{}' is unsuitable: {}", d, device.properties.deviceName, device.incompatibilityReason), LogLevel::INFORMATION);
+				}
+			}
+
+			const PhysicalDeviceInformation& Select()
+			{
+				String preferredDevice = Settings::GetInstance()->Get<String>("preferredDevice");
+
+				if (!preferredDevice.empty())
+				{
+					for (Size d = 0; d < devices.size(); d++)
+					{
+						const PhysicalDeviceInformation& device = devices[d];
+
+						if (!MatchesPreference(device, d, preferredDevice))
+							continue;
+
+						if (device.isCompatible)
+						{
+							Logger_WriteConsole(Formatter::Format("Using preferred device '{}'", device.properties.deviceName), LogLevel::INFORMATION);
+							return device;
+						}
+
+						Logger_WriteConsole(Formatter::Format("Preferred device '{}' is unsuitable: {}", device.properties.deviceName, device.incompatibilityReason), LogLevel::WARNING);
+					}
+
+					Logger_WriteConsole(Formatter::Format("No suitable device matches '{}', falling back to automatic selection", preferredDevice), LogLevel::WARNING);
+				}
+
+				const PhysicalDeviceInformation* best = nullptr;
+
+				for (const PhysicalDeviceInformation& device : devices)
+				{
+					if (device.isCompatible && (best == nullptr || device.score > best->score))
+						best = &device;
+				}
+
+				if (best == nullptr)
+					Logger_ThrowException("failed to find a suitable GPU!", true);
+
+				return *best;
+			}
+
+			const PhysicalDeviceInformation& Get(VkPhysicalDevice handle) const
+			{
+				for (const PhysicalDeviceInformation& device : devices)
+				{
+					if (device.handle == handle)
+						return device;
+				}
+
+				Logger_ThrowException("Physical device has not been registered in the device database", true);
+			}
+
+			const Vector<PhysicalDeviceInformation>& GetDevices() const
+			{
+				return devices;
+			}
+
+			static Shared<PhysicalDeviceDatabase> GetInstance()
+			{
+				class EnabledPhysicalDeviceDatabase : public PhysicalDeviceDatabase { };
+
+				static Shared<PhysicalDeviceDatabase> instance = std::make_shared<EnabledPhysicalDeviceDatabase>();
+
+				return instance;
+			}
+
+		private:
+
+			PhysicalDeviceDatabase() = default;
+
+			static PhysicalDeviceInformation QueryDevice(VkPhysicalDevice handle, VkSurfaceKHR surface, uint instanceApiVersion, const Vector<const char*>& requiredExtensions)
+			{
+				PhysicalDeviceInformation device;
+
+				device.handle = handle;
+
+				vkGetPhysicalDeviceProperties(handle, &device.properties);
+				vkGetPhysicalDeviceFeatures(handle, &device.features);
+				vkGetPhysicalDeviceMemoryProperties(handle, &device.memoryProperties);
+
+				uint queueFamilyCount = 0;
+				vkGetPhysicalDeviceQueueFamilyProperties(handle, &queueFamilyCount, nullptr);
+
+				device.queueFamilies.resize(queueFamilyCount);
+				vkGetPhysicalDeviceQueueFamilyProperties(handle, &queueFamilyCount, device.queueFamilies.data());
+
+				device.queueFamilyIndices = VulkanHelper::FindQueueFamilies(handle, surface);
+
+				for (uint f = 0; f < queueFamilyCount; f++)
+				{
+					VkQueueFlags flags = device.queueFamilies[f].queueFlags;
+
+					if (!device.dedicatedTransferFamily.has_value() && (flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+						device.dedicatedTransferFamily = f;
+
+					if (!device.dedicatedComputeFamily.has_value() && (flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT))
+						device.dedicatedComputeFamily = f;
+				}
+
+				for (uint h = 0; h < device.memoryProperties.memoryHeapCount; h++)
+				{
+					if (device.memoryProperties.memoryHeaps[h].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+						device.deviceLocalMemory += device.memoryProperties.memoryHeaps[h].size;
+				}
+
+				device.capabilities = DeviceCapabilities::Query(handle, instanceApiVersion);
+
+				if (!device.queueFamilyIndices.IsSet())
+				{
+					device.incompatibilityReason = "no graphics or present queue";
+					return device;
+				}
+
+				for (const char* extension : requiredExtensions)
+				{
+					if (!device.capabilities.HasExtension(extension))
+					{
+						device.incompatibilityReason = Formatter::Format("missing extension '{}'", extension);
+						return device;
+					}
+				}
+
+				if (surface != VK_NULL_HANDLE)
+				{
+					device.swapChainSupport = VulkanHelper::GetSwapChainSupport(handle, surface);
+
+					if (device.swapChainSupport.formats.empty() || device.swapChainSupport.presentModes.empty())
+					{
+						device.incompatibilityReason = "inadequate swap chain support";
+						return device;
+					}
+				}
+
+				if (!device.capabilities.MeetsRequirements())
+				{
+					device.incompatibilityReason = "Vulkan 1.2 with timeline semaphores is required";
+					return device;
+				}
+
+				device.isCompatible = true;
+				device.score = Score(device);
+
+				return device;
+			}
+
+			static int Score(const PhysicalDeviceInformation& device)
+			{
+				int score = 0;
+
+				switch (device.properties.deviceType)
+				{
+				case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+					score += 10000;
+					break;
+
+				case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+					score += 5000;
+					break;
+
+				case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+					score += 2500;
+					break;
+
+				case VK_PHYSICAL_DEVICE_TYPE_CPU:
+					score += 1000;
+					break;
+
+				default:
+					break;
+				}
+
+				score += static_cast<int>(std::min<VkDeviceSize>(device.deviceLocalMemory >> 26, 1024));
+
+				if (device.queueFamilyIndices.graphicsFamily == device.queueFamilyIndices.presentFamily)
+					score += 100;
+
+				if (device.dedicatedTransferFamily.has_value())
+					score += 200;
+
+				if (device.dedicatedComputeFamily.has_value())
+					score += 100;
+
+				for (const auto& [feature, name] : DeviceCapabilities::GetFeatureNames())
+				{
+					if (device.capabilities.IsSupported(feature))
+						score += 50;
+				}
+
+				return score;
+			}
+
+			static bool MatchesPreference(const PhysicalDeviceInformation& device, Size index, const String& preferredDevice)
+			{
+				if (std::all_of(preferredDevice.begin(), preferredDevice.end(), [](char character) { return std::isdigit(static_cast<uchar>(character)); }))
+					return std::stoul(preferredDevice) == index;
+
+				String name = device.properties.deviceName;
+				String preference = preferredDevice;
+
+				std::transform(name.begin(), name.end(), name.begin(), [](char character) { return static_cast<char>(std::tolower(static_cast<uchar>(character))); });
+				std::transform(preference.begin(), preference.end(), preference.begin(), [](char character) { return static_cast<char>(std::tolower(static_cast<uchar>(character))); });
+
+				return name.find(preference) != String::npos;
+			}
+
+			Vector<PhysicalDeviceInformation> devices;
+
+		};
+	}
+}
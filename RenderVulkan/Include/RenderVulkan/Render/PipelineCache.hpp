@@ -0,0 +1,286 @@
+#pragma once
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Core/Settings.hpp"
+#include "RenderVulkan/Util/FileHelper.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+using namespace RenderVulkan::Core;
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		class PipelineCache
+		{
+
+		public:
+
+			PipelineCache(const PipelineCache&) = delete;
+			PipelineCache& operator=(const PipelineCache&) = delete;
+
+			void Initialize(const String& path)
+			{
+				device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
+				cachePath = path;
+
+				QueryDevice(Settings::GetInstance()->GetPointer<VkPhysicalDevice>("physicalDevice"));
+
+				Vector<char> initialData = Load();
+
+				VkPipelineCacheCreateInfo cacheInformation = {};
+
+				cacheInformation.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+				cacheInformation.initialDataSize = initialData.size();
+				cacheInformation.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+				VkResult result = vkCreatePipelineCache(device, &cacheInformation, nullptr, &pipelineCache);
+
+				if (result != VK_SUCCESS && !initialData.empty())
+				{
+					Logger_WriteConsole(Formatter::Format("Driver rejected pipeline cache '{}', starting empty", cachePath), LogLevel::WARNING);
+
+					cacheInformation.initialDataSize = 0;
+					cacheInformation.pInitialData = nullptr;
+
+					result = vkCreatePipelineCache(device, &cacheInformation, nullptr, &pipelineCache);
+				}
+
+				Logger_ThrowIfFailed(result, "Failed to create pipeline cache", true);
+
+				loadedSize = initialData.size();
+			}
+
+			void Save()
+			{
+				if (pipelineCache == VK_NULL_HANDLE || cachePath.empty())
+					return;
+
+				Size dataSize = 0;
+
+				VkResult result = vkGetPipelineCacheData(device, pipelineCache, &dataSize, nullptr);
+
+				if (result != VK_SUCCESS || dataSize == 0)
+					return;
+
+				Vector<char> data(dataSize);
+
+				result = vkGetPipelineCacheData(device, pipelineCache, &dataSize, data.data());
+
+				if (result != VK_SUCCESS)
+				{
+					Logger_WriteConsole("Failed to read back pipeline cache data", LogLevel::WARNING);
+					return;
+				}
+
+				data.resize(dataSize);
+
+				CacheFileHeader header = CreateHeader();
+
+				header.dataSize = data.size();
+				header.checksum = Hash(data.data(), data.size());
+
+				String temporaryPath = cachePath + ".tmp";
+
+				{
+					OutputFileStream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+					if (!file.is_open())
+					{
+						Logger_WriteConsole(Formatter::Format("Failed to open '{}' for the pipeline cache", temporaryPath), LogLevel::WARNING);
+						return;
+					}
+
+					file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+					file.write(data.data(), static_cast<std::streamsize>(data.size()));
+
+					if (!file.good())
+					{
+						Logger_WriteConsole(Formatter::Format("Failed to write pipeline cache to '{}'", temporaryPath), LogLevel::WARNING);
+						return;
+					}
+				}
+
+				std::error_code error;
+				std::filesystem::rename(temporaryPath, cachePath, error);
+
+				if (error)
+				{
+					Logger_WriteConsole(Formatter::Format("Failed to replace pipeline cache '{}': {}", cachePath, error.message()), LogLevel::WARNING);
+					std::filesystem::remove(temporaryPath, error);
+
+					return;
+				}
+
+				Logger_WriteConsole(Formatter::Format("Saved '{}' KiB pipeline cache to '{}' (loaded '{}' KiB)", data.size() / 1024, cachePath, loadedSize / 1024), LogLevel::INFORMATION);
+			}
+
+			VkPipelineCache Get() const
+			{
+				return pipelineCache;
+			}
+
+			void CleanUp()
+			{
+				Save();
+
+				if (pipelineCache != VK_NULL_HANDLE)
+					vkDestroyPipelineCache(device, pipelineCache, nullptr);
+
+				pipelineCache = VK_NULL_HANDLE;
+			}
+
+			static Shared<PipelineCache> GetInstance()
+			{
+				class EnabledPipelineCache : public PipelineCache { };
+
+				static Shared<PipelineCache> instance = std::make_shared<EnabledPipelineCache>();
+
+				return instance;
+			}
+
+			static constexpr uint FILE_MAGIC = 0x43505652;
+			static constexpr uint FILE_VERSION = 1;
+
+		private:
+
+			struct CacheFileHeader
+			{
+				uint magic = FILE_MAGIC;
+				uint version = FILE_VERSION;
+				uint vendorId = 0;
+				uint deviceId = 0;
+				uint driverVersion = 0;
+				uint padding = 0;
+				uchar driverUuid[VK_UUID_SIZE] = {};
+				uchar pipelineCacheUuid[VK_UUID_SIZE] = {};
+				ullong dataSize = 0;
+				ullong checksum = 0;
+			};
+
+			PipelineCache() = default;
+
+			void QueryDevice(VkPhysicalDevice physicalDevice)
+			{
+				VkPhysicalDeviceIDProperties idProperties = {};
+
+				idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+
+				VkPhysicalDeviceProperties2 properties = {};
+
+				properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+				properties.pNext = &idProperties;
+
+				vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+
+				deviceProperties = properties.properties;
+				std::memcpy(driverUuid, idProperties.driverUUID, VK_UUID_SIZE);
+			}
+
+			CacheFileHeader CreateHeader() const
+			{
+				CacheFileHeader header = {};
+
+				header.vendorId = deviceProperties.vendorID;
+				header.deviceId = deviceProperties.deviceID;
+				header.driverVersion = deviceProperties.driverVersion;
+
+				std::memcpy(header.driverUuid, driverUuid, VK_UUID_SIZE);
+				std::memcpy(header.pipelineCacheUuid, deviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+
+				return header;
+			}
+
+			Vector<char> Load() const
+			{
+				if (cachePath.empty() || !std::filesystem::exists(cachePath))
+					return {};
+
+				Vector<char> file = FileHelper::ReadFileIntoVector(cachePath);
+
+				String reason = Validate(file);
+
+				if (!reason.empty())
+				{
+					Logger_WriteConsole(Formatter::Format("Discarding pipeline cache '{}': {}", cachePath, reason), LogLevel::WARNING);
+					return {};
+				}
+
+				Logger_WriteConsole(Formatter::Format("Loaded pipeline cache '{}'", cachePath), LogLevel::INFORMATION);
+
+				return Vector<char>(file.begin() + sizeof(CacheFileHeader), file.end());
+			}
+
+			String Validate(const Vector<char>& file) const
+			{
+				if (file.size() < sizeof(CacheFileHeader))
+					return "file is truncated";
+
+				CacheFileHeader header;
+				std::memcpy(&header, file.data(), sizeof(header));
+
+				CacheFileHeader expected = CreateHeader();
+
+				if (header.magic != FILE_MAGIC || header.version != FILE_VERSION)
+					return "unrecognized file format";
+
+				if (header.vendorId != expected.vendorId || header.deviceId != expected.deviceId)
+					return "created on a different device";
+
+				if (header.driverVersion != expected.driverVersion || std::memcmp(header.driverUuid, expected.driverUuid, VK_UUID_SIZE) != 0)
+					return "created by a different driver";
+
+				if (std::memcmp(header.pipelineCacheUuid, expected.pipelineCacheUuid, VK_UUID_SIZE) != 0)
+					return "pipeline cache UUID mismatch";
+
+				if (header.dataSize != file.size() - sizeof(CacheFileHeader))
+					return "size mismatch";
+
+				const char* data = file.data() + sizeof(CacheFileHeader);
+
+				if (header.checksum != Hash(data, static_cast<Size>(header.dataSize)))
+					return "checksum mismatch";
+
+				if (header.dataSize < sizeof(VkPipelineCacheHeaderVersionOne))
+					return "driver header is truncated";
+
+				VkPipelineCacheHeaderVersionOne driverHeader;
+				std::memcpy(&driverHeader, data, sizeof(driverHeader));
+
+				if (driverHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE || driverHeader.headerSize < sizeof(VkPipelineCacheHeaderVersionOne) || driverHeader.headerSize > header.dataSize)
+					return "driver header is malformed";
+
+				if (driverHeader.vendorID != expected.vendorId || driverHeader.deviceID != expected.deviceId || std::memcmp(driverHeader.pipelineCacheUUID, expected.pipelineCacheUuid, VK_UUID_SIZE) != 0)
+					return "driver header does not match this device";
+
+				return {};
+			}
+
+			static ullong Hash(const char* data, Size size)
+			{
+				ullong hash = 14695981039346656037ull;
+
+				for (Size i = 0; i < size; i++)
+				{
+					hash ^= static_cast<uchar>(data[i]);
+					hash *= 1099511628211ull;
+				}
+
+				return hash;
+			}
+
+			VkDevice device = VK_NULL_HANDLE;
+			VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+
+			VkPhysicalDeviceProperties deviceProperties = {};
+			uchar driverUuid[VK_UUID_SIZE] = {};
+
+			String cachePath;
+			Size loadedSize = 0;
+
+		};
+	}
+}
@@ -0,0 +1,996 @@
+#pragma once
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Core/Settings.hpp"
+#include "RenderVulkan/Render/ChangeTracker.hpp"
+#include "RenderVulkan/Render/DeviceCapabilities.hpp"
+#include "RenderVulkan/Render/PipelineCache.hpp"
+#include "RenderVulkan/Render/ShaderVariantKey.hpp"
+#include "RenderVulkan/Render/TimelineScheduler.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+using namespace RenderVulkan::Core;
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		enum class BlendMode
+		{
+			DISABLED,
+			ALPHA,
+			ADDITIVE,
+			PREMULTIPLIED
+		};
+
+		enum class PipelineLibraryPart
+		{
+			VERTEX_INPUT,
+			PRE_RASTERIZATION,
+			FRAGMENT_SHADER,
+			FRAGMENT_OUTPUT
+		};
+
+		using PipelineSlot = Shared<Atomic<VkPipeline>>;
+
+		struct PipelineStateKey
+		{
+			VkShaderModule vertexShader = VK_NULL_HANDLE;
+			VkShaderModule fragmentShader = VK_NULL_HANDLE;
+			VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+			ShaderVariantKey specialization;
+
+			VkVertexInputBindingDescription vertexBinding = {};
+			Vector<VkVertexInputAttributeDescription> vertexAttributes;
+
+			VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+			VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
+			VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+			VkFrontFace frontFace = VK_FRONT_FACE_CLOCKWISE;
+
+			bool depthTest = true;
+			bool depthWrite = true;
+			VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS;
+
+			BlendMode blendMode = BlendMode::DISABLED;
+			uint colorAttachmentCount = 1;
+
+			VkSampleCountFlagBits sampleCount = VK_SAMPLE_COUNT_1_BIT;
+			float minSampleShading = 0.0f;
+
+			ullong renderPassCompatibility = 0;
+
+			bool hasDynamicRasterState = false;
+			bool hasDynamicBlendEnable = false;
+
+			ullong Hash() const
+			{
+				ullong hash = 14695981039346656037ull;
+
+				auto combine = [&hash](ullong value)
+				{
+					for (int b = 0; b < 8; b++)
+					{
+						hash ^= (value >> (b * 8)) & 0xFF;
+						hash *= 1099511628211ull;
+					}
+				};
+
+				combine(reinterpret_cast<ullong>(vertexShader));
+				combine(reinterpret_cast<ullong>(fragmentShader));
+				combine(reinterpret_cast<ullong>(pipelineLayout));
+				combine(specialization.Hash());
+				combine(vertexBinding.binding);
+				combine(vertexBinding.stride);
+				combine(vertexBinding.inputRate);
+
+				for (const VkVertexInputAttributeDescription& attribute : vertexAttributes)
+				{
+					combine(attribute.location);
+					combine(attribute.binding);
+					combine(attribute.format);
+					combine(attribute.offset);
+				}
+
+				combine(topology);
+				combine(polygonMode);
+				combine(cullMode);
+				combine(frontFace);
+				combine(depthTest);
+				combine(depthWrite);
+				combine(depthCompareOp);
+				combine(static_cast<ullong>(blendMode));
+				combine(colorAttachmentCount);
+				combine(sampleCount);
+
+				uint minSampleShadingBits;
+				std::memcpy(&minSampleShadingBits, &minSampleShading, sizeof(minSampleShadingBits));
+
+				combine(minSampleShadingBits);
+				combine(renderPassCompatibility);
+				combine(hasDynamicRasterState);
+				combine(hasDynamicBlendEnable);
+
+				return hash;
+			}
+
+			bool operator==(const PipelineStateKey& other) const
+			{
+				if (vertexAttributes.size() != other.vertexAttributes.size())
+					return false;
+
+				for (Size a = 0; a < vertexAttributes.size(); a++)
+				{
+					const VkVertexInputAttributeDescription& left = vertexAttributes[a];
+					const VkVertexInputAttributeDescription& right = other.vertexAttributes[a];
+
+					if (left.location != right.location || left.binding != right.binding || left.format != right.format || left.offset != right.offset)
+						return false;
+				}
+
+				return vertexShader == other.vertexShader && fragmentShader == other.fragmentShader && pipelineLayout == other.pipelineLayout && specialization == other.specialization &&
+					vertexBinding.binding == other.vertexBinding.binding && vertexBinding.stride == other.vertexBinding.stride && vertexBinding.inputRate == other.vertexBinding.inputRate &&
+					topology == other.topology && polygonMode == other.polygonMode && cullMode == other.cullMode && frontFace == other.frontFace &&
+					depthTest == other.depthTest && depthWrite == other.depthWrite && depthCompareOp == other.depthCompareOp &&
+					blendMode == other.blendMode && colorAttachmentCount == other.colorAttachmentCount &&
+					sampleCount == other.sampleCount && minSampleShading == other.minSampleShading &&
+					renderPassCompatibility == other.renderPassCompatibility &&
+					hasDynamicRasterState == other.hasDynamicRasterState && hasDynamicBlendEnable == other.hasDynamicBlendEnable;
+			}
+		};
+
+		class PipelineStateCache
+		{
+
+		public:
+
+			PipelineStateCache(const PipelineStateCache&) = delete;
+			PipelineStateCache& operator=(const PipelineStateCache&) = delete;
+
+			~PipelineStateCache()
+			{
+				StopBackgroundLinking();
+			}
+
+			void Initialize()
+			{
+				device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
+				isLibrarySupported = Settings::GetInstance()->Get<DeviceCapabilities>("deviceCapabilities").IsSupported(DeviceFeature::GRAPHICS_PIPELINE_LIBRARY);
+
+				if (!isLibrarySupported)
+					return;
+
+				isStopping = false;
+				linkThread = Thread([this] { RunLinkJobs(); });
+
+				Logger_WriteConsole("Pipeline state cache: graphics pipeline libraries enabled, optimized links run in the background", LogLevel::INFORMATION);
+			}
+
+			PipelineSlot GetOrCreate(PipelineStateKey key, VkRenderPass renderPass)
+			{
+				ullong hash = 0;
+
+				{
+					LockGuard<Mutex> lock(mutex);
+
+					key.renderPassCompatibility = GetCompatibility(renderPass);
+					hash = key.Hash();
+
+					PipelineSlot cachedSlot = Find(hash, key);
+
+					if (cachedSlot)
+					{
+						hitCount++;
+						return cachedSlot;
+					}
+				}
+
+				LinkJob job;
+
+				VkPipeline pipeline = isLibrarySupported ? CreateLinkedPipeline(key, renderPass, job) : CreatePipeline(key, renderPass);
+
+				PipelineSlot slot = std::make_shared<Atomic<VkPipeline>>(pipeline);
+
+				{
+					LockGuard<Mutex> lock(mutex);
+
+					PipelineSlot cachedSlot = Find(hash, key);
+
+					if (cachedSlot)
+					{
+						vkDestroyPipeline(device, pipeline, nullptr);
+
+						hitCount++;
+						return cachedSlot;
+					}
+
+					missCount++;
+
+					pipelines[hash].push_back({ key, slot });
+				}
+
+				job.slot = slot;
+
+				if (job.fastPipeline != VK_NULL_HANDLE)
+				{
+					{
+						LockGuard<Mutex> lock(linkMutex);
+
+						pendingLinks.push_back(job);
+					}
+
+					linkAvailable.notify_one();
+				}
+
+				return slot;
+			}
+
+			void Evict(const Vector<VkShaderModule>& modules)
+			{
+				auto usesModule = [&modules](const PipelineStateKey& key)
+				{
+					return std::find(modules.begin(), modules.end(), key.vertexShader) != modules.end() || (key.fragmentShader != VK_NULL_HANDLE && std::find(modules.begin(), modules.end(), key.fragmentShader) != modules.end());
+				};
+
+				Vector<VkPipeline> evicted;
+				Set<PipelineSlot> evictedSlots;
+
+				{
+					LockGuard<Mutex> lock(mutex);
+
+					for (auto& [hash, bucket] : pipelines)
+					{
+						std::erase_if(bucket, [&](const Pair<PipelineStateKey, PipelineSlot>& entry)
+						{
+							if (!usesModule(entry.first))
+								return false;
+
+							evicted.push_back(entry.second->exchange(VK_NULL_HANDLE));
+							evictedSlots.insert(entry.second);
+							return true;
+						});
+					}
+				}
+
+				{
+					UniqueLock lock(linkMutex);
+
+					std::erase_if(pendingLinks, [&evictedSlots](const LinkJob& job) { return evictedSlots.contains(job.slot); });
+
+					linkFinished.wait(lock, [this] { return !isLinking; });
+				}
+
+				{
+					LockGuard<Mutex> lock(libraryMutex);
+
+					for (auto& libraryMap : libraries)
+					{
+						for (auto& [hash, bucket] : libraryMap)
+						{
+							std::erase_if(bucket, [&](const Pair<PipelineStateKey, VkPipeline>& entry)
+							{
+								if (!usesModule(entry.first))
+									return false;
+
+								evicted.push_back(entry.second);
+								return true;
+							});
+						}
+					}
+				}
+
+				if (evicted.empty())
+					return;
+
+				VkDevice retiredDevice = device;
+
+				TimelineScheduler::GetInstance()->OnLastSubmittedComplete([retiredDevice, evicted]()
+				{
+					for (VkPipeline pipeline : evicted)
+						vkDestroyPipeline(retiredDevice, pipeline, nullptr);
+				});
+			}
+
+			static VkPipeline Resolve(const PipelineSlot& slot)
+			{
+				return slot ? slot->load() : VK_NULL_HANDLE;
+			}
+
+			void Update()
+			{
+				Vector<LinkResult> results;
+
+				{
+					LockGuard<Mutex> lock(linkMutex);
+
+					if (completedLinks.empty())
+						return;
+
+					results.swap(completedLinks);
+				}
+
+				LockGuard<Mutex> lock(mutex);
+
+				for (const LinkResult& linkResult : results)
+				{
+					VkPipeline expectedPipeline = linkResult.fastPipeline;
+
+					if (!linkResult.slot->compare_exchange_strong(expectedPipeline, linkResult.optimizedPipeline))
+					{
+						vkDestroyPipeline(device, linkResult.optimizedPipeline, nullptr);
+						continue;
+					}
+
+					replacementCount++;
+
+					VkDevice retiredDevice = device;
+					VkPipeline retiredPipeline = linkResult.fastPipeline;
+
+					TimelineScheduler::GetInstance()->OnLastSubmittedComplete([retiredDevice, retiredPipeline]()
+					{
+						vkDestroyPipeline(retiredDevice, retiredPipeline, nullptr);
+					});
+				}
+
+				ChangeTracker::GetInstance()->Invalidate();
+			}
+
+			void RegisterRenderPass(VkRenderPass renderPass, ullong compatibility)
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				renderPassCompatibilities[renderPass] = compatibility;
+			}
+
+			void UnregisterRenderPass(VkRenderPass renderPass)
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				renderPassCompatibilities.erase(renderPass);
+			}
+
+			bool IsLibrarySupported() const
+			{
+				return isLibrarySupported;
+			}
+
+			Size GetHitCount() const
+			{
+				return hitCount;
+			}
+
+			Size GetMissCount() const
+			{
+				return missCount;
+			}
+
+			Size GetPipelineCount()
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				Size count = 0;
+
+				for (const auto& [hash, bucket] : pipelines)
+					count += bucket.size();
+
+				return count;
+			}
+
+			Size GetLibraryCount()
+			{
+				LockGuard<Mutex> lock(libraryMutex);
+
+				Size count = 0;
+
+				for (const auto& libraryMap : libraries)
+				{
+					for (const auto& [hash, bucket] : libraryMap)
+						count += bucket.size();
+				}
+
+				return count;
+			}
+
+			void LogStatistics()
+			{
+				Logger_WriteConsole(Formatter::Format("Pipeline state cache: '{}' pipelines, '{}' hits, '{}' misses", GetPipelineCount(), hitCount.load(), missCount.load()), LogLevel::INFORMATION);
+
+				if (isLibrarySupported)
+					Logger_WriteConsole(Formatter::Format("Pipeline state cache: '{}' libraries, '{}' of '{}' fast links replaced by optimized links", GetLibraryCount(), replacementCount.load(), missCount.load()), LogLevel::INFORMATION);
+			}
+
+			void StopBackgroundLinking()
+			{
+				{
+					LockGuard<Mutex> lock(linkMutex);
+
+					isStopping = true;
+					pendingLinks.clear();
+				}
+
+				linkAvailable.notify_all();
+
+				if (linkThread.joinable())
+					linkThread.join();
+			}
+
+			void CleanUp()
+			{
+				StopBackgroundLinking();
+
+				LogStatistics();
+
+				{
+					LockGuard<Mutex> lock(linkMutex);
+
+					for (const LinkResult& linkResult : completedLinks)
+						vkDestroyPipeline(device, linkResult.optimizedPipeline, nullptr);
+
+					completedLinks.clear();
+				}
+
+				LockGuard<Mutex> lock(mutex);
+				LockGuard<Mutex> libraryLock(libraryMutex);
+
+				for (const auto& [hash, bucket] : pipelines)
+				{
+					for (const auto& [key, slot] : bucket)
+						vkDestroyPipeline(device, slot->exchange(VK_NULL_HANDLE), nullptr);
+				}
+
+				for (auto& libraryMap : libraries)
+				{
+					for (const auto& [hash, bucket] : libraryMap)
+					{
+						for (const auto& [key, library] : bucket)
+							vkDestroyPipeline(device, library, nullptr);
+					}
+
+					libraryMap.clear();
+				}
+
+				pipelines.clear();
+				renderPassCompatibilities.clear();
+
+				hitCount = 0;
+				missCount = 0;
+				replacementCount = 0;
+			}
+
+			static Shared<PipelineStateCache> GetInstance()
+			{
+				class EnabledPipelineStateCache : public PipelineStateCache { };
+
+				static Shared<PipelineStateCache> instance = std::make_shared<EnabledPipelineStateCache>();
+
+				return instance;
+			}
+
+		private:
+
+			struct LinkJob
+			{
+				PipelineSlot slot;
+				VkPipeline fastPipeline = VK_NULL_HANDLE;
+				VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+				Array<VkPipeline, 4> parts = {};
+			};
+
+			struct LinkResult
+			{
+				PipelineSlot slot;
+				VkPipeline fastPipeline = VK_NULL_HANDLE;
+				VkPipeline optimizedPipeline = VK_NULL_HANDLE;
+			};
+
+			struct PipelineCreateState
+			{
+				PipelineCreateState(const PipelineStateKey& key, Optional<PipelineLibraryPart> part = std::nullopt) : colorBlendAttachments(key.colorAttachmentCount, GetBlendState(key.blendMode))
+				{
+					for (const auto& [constantId, value] : key.specialization.constants)
+					{
+						specializationEntries.push_back({ constantId, static_cast<uint>(specializationData.size() * sizeof(uint)), sizeof(uint) });
+						specializationData.push_back(value);
+					}
+
+					specializationInformation.mapEntryCount = static_cast<uint>(specializationEntries.size());
+					specializationInformation.pMapEntries = specializationEntries.data();
+					specializationInformation.dataSize = specializationData.size() * sizeof(uint);
+					specializationInformation.pData = specializationData.data();
+
+					VkPipelineShaderStageCreateInfo vertexShaderStageInformation{};
+
+					vertexShaderStageInformation.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+					vertexShaderStageInformation.stage = VK_SHADER_STAGE_VERTEX_BIT;
+					vertexShaderStageInformation.module = key.vertexShader;
+					vertexShaderStageInformation.pName = "Main";
+					vertexShaderStageInformation.pSpecializationInfo = specializationEntries.empty() ? nullptr : &specializationInformation;
+
+					vertexStages.push_back(vertexShaderStageInformation);
+
+					if (key.fragmentShader != VK_NULL_HANDLE)
+					{
+						VkPipelineShaderStageCreateInfo fragmentShaderStageInformation{};
+
+						fragmentShaderStageInformation.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+						fragmentShaderStageInformation.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+						fragmentShaderStageInformation.module = key.fragmentShader;
+						fragmentShaderStageInformation.pName = "Main";
+						fragmentShaderStageInformation.pSpecializationInfo = specializationEntries.empty() ? nullptr : &specializationInformation;
+
+						fragmentStages.push_back(fragmentShaderStageInformation);
+					}
+
+					allStages = vertexStages;
+					allStages.insert(allStages.end(), fragmentStages.begin(), fragmentStages.end());
+
+					Vector<VkDynamicState> candidateStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+
+					if (key.hasDynamicRasterState)
+						candidateStates.insert(candidateStates.end(), { VK_DYNAMIC_STATE_CULL_MODE_EXT, VK_DYNAMIC_STATE_FRONT_FACE_EXT, VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT, VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT, VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT, VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT });
+
+					if (key.hasDynamicBlendEnable)
+						candidateStates.push_back(VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT);
+
+					for (VkDynamicState candidateState : candidateStates)
+					{
+						if (!part.has_value() || GetDynamicStatePart(candidateState) == part.value())
+							dynamicStates.push_back(candidateState);
+					}
+
+					dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+					dynamicState.dynamicStateCount = static_cast<uint>(dynamicStates.size());
+					dynamicState.pDynamicStates = dynamicStates.data();
+
+					vertexBinding = key.vertexBinding;
+
+					vertexInputInformation.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+					vertexInputInformation.vertexBindingDescriptionCount = key.vertexAttributes.empty() ? 0 : 1;
+					vertexInputInformation.pVertexBindingDescriptions = &vertexBinding;
+					vertexInputInformation.vertexAttributeDescriptionCount = static_cast<uint>(key.vertexAttributes.size());
+					vertexInputInformation.pVertexAttributeDescriptions = key.vertexAttributes.data();
+
+					inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+					inputAssembly.topology = key.topology;
+					inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+					viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+					viewportState.viewportCount = 1;
+					viewportState.scissorCount = 1;
+
+					rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+					rasterizer.depthClampEnable = VK_FALSE;
+					rasterizer.rasterizerDiscardEnable = VK_FALSE;
+					rasterizer.polygonMode = key.polygonMode;
+					rasterizer.lineWidth = 1.0f;
+					rasterizer.cullMode = key.cullMode;
+					rasterizer.frontFace = key.frontFace;
+					rasterizer.depthBiasEnable = VK_FALSE;
+
+					multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+					multisampling.sampleShadingEnable = key.minSampleShading > 0.0f ? VK_TRUE : VK_FALSE;
+					multisampling.rasterizationSamples = key.sampleCount;
+					multisampling.minSampleShading = key.minSampleShading > 0.0f ? std::min(key.minSampleShading, 1.0f) : 1.0f;
+					multisampling.pSampleMask = nullptr;
+					multisampling.alphaToCoverageEnable = VK_FALSE;
+					multisampling.alphaToOneEnable = VK_FALSE;
+
+					depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+					depthStencil.depthTestEnable = key.depthTest ? VK_TRUE : VK_FALSE;
+					depthStencil.depthWriteEnable = key.depthWrite ? VK_TRUE : VK_FALSE;
+					depthStencil.depthCompareOp = key.depthCompareOp;
+					depthStencil.depthBoundsTestEnable = VK_FALSE;
+					depthStencil.stencilTestEnable = VK_FALSE;
+					depthStencil.minDepthBounds = 0.0f;
+					depthStencil.maxDepthBounds = 1.0f;
+
+					colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+					colorBlending.logicOpEnable = VK_FALSE;
+					colorBlending.logicOp = VK_LOGIC_OP_COPY;
+					colorBlending.attachmentCount = static_cast<uint>(colorBlendAttachments.size());
+					colorBlending.pAttachments = colorBlendAttachments.data();
+				}
+
+				PipelineCreateState(const PipelineCreateState&) = delete;
+				PipelineCreateState& operator=(const PipelineCreateState&) = delete;
+
+				Vector<VkSpecializationMapEntry> specializationEntries;
+				Vector<uint> specializationData;
+				VkSpecializationInfo specializationInformation{};
+
+				Vector<VkPipelineShaderStageCreateInfo> vertexStages;
+				Vector<VkPipelineShaderStageCreateInfo> fragmentStages;
+				Vector<VkPipelineShaderStageCreateInfo> allStages;
+
+				Vector<VkDynamicState> dynamicStates;
+				VkPipelineDynamicStateCreateInfo dynamicState{};
+
+				VkVertexInputBindingDescription vertexBinding{};
+				VkPipelineVertexInputStateCreateInfo vertexInputInformation{};
+				VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+				VkPipelineViewportStateCreateInfo viewportState{};
+				VkPipelineRasterizationStateCreateInfo rasterizer{};
+				VkPipelineMultisampleStateCreateInfo multisampling{};
+				VkPipelineDepthStencilStateCreateInfo depthStencil{};
+
+				Vector<VkPipelineColorBlendAttachmentState> colorBlendAttachments;
+				VkPipelineColorBlendStateCreateInfo colorBlending{};
+			};
+
+			PipelineStateCache() = default;
+
+			PipelineSlot Find(ullong hash, const PipelineStateKey& key)
+			{
+				for (const auto& [cachedKey, cachedSlot] : pipelines[hash])
+				{
+					if (cachedKey == key)
+						return cachedSlot;
+				}
+
+				return nullptr;
+			}
+
+			ullong GetCompatibility(VkRenderPass renderPass) const
+			{
+				if (renderPassCompatibilities.contains(renderPass))
+					return renderPassCompatibilities.at(renderPass);
+
+				return reinterpret_cast<ullong>(renderPass);
+			}
+
+			static PipelineStateKey GetPartKey(const PipelineStateKey& key, PipelineLibraryPart part)
+			{
+				PipelineStateKey partKey;
+
+				switch (part)
+				{
+
+				case PipelineLibraryPart::VERTEX_INPUT:
+					partKey.hasDynamicRasterState = key.hasDynamicRasterState;
+					partKey.vertexBinding = key.vertexBinding;
+					partKey.vertexAttributes = key.vertexAttributes;
+					partKey.topology = key.topology;
+					break;
+
+				case PipelineLibraryPart::PRE_RASTERIZATION:
+					partKey.hasDynamicRasterState = key.hasDynamicRasterState;
+					partKey.vertexShader = key.vertexShader;
+					partKey.pipelineLayout = key.pipelineLayout;
+					partKey.specialization = key.specialization;
+					partKey.polygonMode = key.polygonMode;
+					partKey.cullMode = key.cullMode;
+					partKey.frontFace = key.frontFace;
+					partKey.renderPassCompatibility = key.renderPassCompatibility;
+					break;
+
+				case PipelineLibraryPart::FRAGMENT_SHADER:
+					partKey.hasDynamicRasterState = key.hasDynamicRasterState;
+					partKey.fragmentShader = key.fragmentShader;
+					partKey.pipelineLayout = key.pipelineLayout;
+					partKey.specialization = key.specialization;
+					partKey.depthTest = key.depthTest;
+					partKey.depthWrite = key.depthWrite;
+					partKey.depthCompareOp = key.depthCompareOp;
+					partKey.sampleCount = key.sampleCount;
+					partKey.minSampleShading = key.minSampleShading;
+					partKey.renderPassCompatibility = key.renderPassCompatibility;
+					break;
+
+				case PipelineLibraryPart::FRAGMENT_OUTPUT:
+					partKey.hasDynamicBlendEnable = key.hasDynamicBlendEnable;
+					partKey.blendMode = key.blendMode;
+					partKey.colorAttachmentCount = key.colorAttachmentCount;
+					partKey.sampleCount = key.sampleCount;
+					partKey.minSampleShading = key.minSampleShading;
+					partKey.renderPassCompatibility = key.renderPassCompatibility;
+					break;
+				}
+
+				return partKey;
+			}
+
+			static PipelineLibraryPart GetDynamicStatePart(VkDynamicState dynamicState)
+			{
+				switch (dynamicState)
+				{
+
+				case VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT:
+					return PipelineLibraryPart::VERTEX_INPUT;
+
+				case VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT:
+				case VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT:
+				case VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT:
+					return PipelineLibraryPart::FRAGMENT_SHADER;
+
+				case VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT:
+					return PipelineLibraryPart::FRAGMENT_OUTPUT;
+
+				default:
+					return PipelineLibraryPart::PRE_RASTERIZATION;
+				}
+			}
+
+			static VkGraphicsPipelineLibraryFlagsEXT GetPartFlags(PipelineLibraryPart part)
+			{
+				switch (part)
+				{
+
+				case PipelineLibraryPart::VERTEX_INPUT:
+					return VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT;
+
+				case PipelineLibraryPart::PRE_RASTERIZATION:
+					return VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT;
+
+				case PipelineLibraryPart::FRAGMENT_SHADER:
+					return VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT;
+
+				default:
+					return VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT;
+				}
+			}
+
+			static VkPipelineColorBlendAttachmentState GetBlendState(BlendMode blendMode)
+			{
+				VkPipelineColorBlendAttachmentState blendState{};
+
+				blendState.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+				blendState.blendEnable = blendMode == BlendMode::DISABLED ? VK_FALSE : VK_TRUE;
+				blendState.colorBlendOp = VK_BLEND_OP_ADD;
+				blendState.alphaBlendOp = VK_BLEND_OP_ADD;
+
+				switch (blendMode)
+				{
+
+				case BlendMode::ALPHA:
+					blendState.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+					blendState.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+					blendState.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+					blendState.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+					break;
+
+				case BlendMode::ADDITIVE:
+					blendState.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+					blendState.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+					blendState.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+					blendState.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+					break;
+
+				case BlendMode::PREMULTIPLIED:
+					blendState.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+					blendState.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+					blendState.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+					blendState.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+					break;
+
+				default:
+					blendState.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+					blendState.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+					blendState.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+					blendState.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+					break;
+				}
+
+				return blendState;
+			}
+
+			VkPipeline CreatePipeline(const PipelineStateKey& key, VkRenderPass renderPass)
+			{
+				PipelineCreateState state(key);
+
+				VkGraphicsPipelineCreateInfo pipelineInformation{};
+
+				pipelineInformation.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+				pipelineInformation.stageCount = static_cast<uint>(state.allStages.size());
+				pipelineInformation.pStages = state.allStages.data();
+				pipelineInformation.pVertexInputState = &state.vertexInputInformation;
+				pipelineInformation.pInputAssemblyState = &state.inputAssembly;
+				pipelineInformation.pViewportState = &state.viewportState;
+				pipelineInformation.pRasterizationState = &state.rasterizer;
+				pipelineInformation.pMultisampleState = &state.multisampling;
+				pipelineInformation.pDepthStencilState = &state.depthStencil;
+				pipelineInformation.pColorBlendState = &state.colorBlending;
+				pipelineInformation.pDynamicState = &state.dynamicState;
+				pipelineInformation.layout = key.pipelineLayout;
+				pipelineInformation.renderPass = renderPass;
+				pipelineInformation.subpass = 0;
+				pipelineInformation.basePipelineHandle = VK_NULL_HANDLE;
+				pipelineInformation.basePipelineIndex = -1;
+
+				VkPipeline pipeline;
+
+				VkResult result = vkCreateGraphicsPipelines(device, PipelineCache::GetInstance()->Get(), 1, &pipelineInformation, nullptr, &pipeline);
+				Logger_ThrowIfFailed(result, "Failed to create graphics pipeline", false);
+
+				return pipeline;
+			}
+
+			VkPipeline GetOrCreateLibrary(const PipelineStateKey& key, PipelineLibraryPart part, VkRenderPass renderPass)
+			{
+				PipelineStateKey partKey = GetPartKey(key, part);
+
+				auto& libraryMap = libraries[static_cast<Size>(part)];
+
+				ullong hash = partKey.Hash();
+
+				for (const auto& [cachedKey, cachedLibrary] : libraryMap[hash])
+				{
+					if (cachedKey == partKey)
+						return cachedLibrary;
+				}
+
+				PipelineCreateState state(key, part);
+
+				VkGraphicsPipelineLibraryCreateInfoEXT libraryInformation{};
+
+				libraryInformation.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+				libraryInformation.flags = GetPartFlags(part);
+
+				VkGraphicsPipelineCreateInfo pipelineInformation{};
+
+				pipelineInformation.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+				pipelineInformation.pNext = &libraryInformation;
+				pipelineInformation.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR | VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
+				pipelineInformation.pDynamicState = state.dynamicStates.empty() ? nullptr : &state.dynamicState;
+				pipelineInformation.basePipelineIndex = -1;
+
+				switch (part)
+				{
+
+				case PipelineLibraryPart::VERTEX_INPUT:
+					pipelineInformation.pVertexInputState = &state.vertexInputInformation;
+					pipelineInformation.pInputAssemblyState = &state.inputAssembly;
+					break;
+
+				case PipelineLibraryPart::PRE_RASTERIZATION:
+					pipelineInformation.stageCount = static_cast<uint>(state.vertexStages.size());
+					pipelineInformation.pStages = state.vertexStages.data();
+					pipelineInformation.pViewportState = &state.viewportState;
+					pipelineInformation.pRasterizationState = &state.rasterizer;
+					pipelineInformation.layout = key.pipelineLayout;
+					pipelineInformation.renderPass = renderPass;
+					break;
+
+				case PipelineLibraryPart::FRAGMENT_SHADER:
+					pipelineInformation.stageCount = static_cast<uint>(state.fragmentStages.size());
+					pipelineInformation.pStages = state.fragmentStages.empty() ? nullptr : state.fragmentStages.data();
+					pipelineInformation.pMultisampleState = &state.multisampling;
+					pipelineInformation.pDepthStencilState = &state.depthStencil;
+					pipelineInformation.layout = key.pipelineLayout;
+					pipelineInformation.renderPass = renderPass;
+					break;
+
+				case PipelineLibraryPart::FRAGMENT_OUTPUT:
+					pipelineInformation.pMultisampleState = &state.multisampling;
+					pipelineInformation.pColorBlendState = &state.colorBlending;
+					pipelineInformation.renderPass = renderPass;
+					break;
+				}
+
+				VkPipeline library;
+
+				VkResult result = vkCreateGraphicsPipelines(device, PipelineCache::GetInstance()->Get(), 1, &pipelineInformation, nullptr, &library);
+				Logger_ThrowIfFailed(result, "Failed to create graphics pipeline library", false);
+
+				libraryMap[hash].push_back({ partKey, library });
+
+				return library;
+			}
+
+			VkPipeline LinkPipeline(const Array<VkPipeline, 4>& parts, VkPipelineLayout pipelineLayout, bool isOptimized) const
+			{
+				VkPipelineLibraryCreateInfoKHR linkInformation{};
+
+				linkInformation.sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+				linkInformation.libraryCount = static_cast<uint>(parts.size());
+				linkInformation.pLibraries = parts.data();
+
+				VkGraphicsPipelineCreateInfo pipelineInformation{};
+
+				pipelineInformation.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+				pipelineInformation.pNext = &linkInformation;
+				pipelineInformation.flags = isOptimized ? VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT : 0;
+				pipelineInformation.layout = pipelineLayout;
+				pipelineInformation.basePipelineIndex = -1;
+
+				VkPipeline pipeline = VK_NULL_HANDLE;
+
+				VkResult result = vkCreateGraphicsPipelines(device, PipelineCache::GetInstance()->Get(), 1, &pipelineInformation, nullptr, &pipeline);
+
+				if (result != VK_SUCCESS)
+					return VK_NULL_HANDLE;
+
+				return pipeline;
+			}
+
+			VkPipeline CreateLinkedPipeline(const PipelineStateKey& key, VkRenderPass renderPass, LinkJob& job)
+			{
+				job.pipelineLayout = key.pipelineLayout;
+
+				{
+					LockGuard<Mutex> lock(libraryMutex);
+
+					job.parts[0] = GetOrCreateLibrary(key, PipelineLibraryPart::VERTEX_INPUT, renderPass);
+					job.parts[1] = GetOrCreateLibrary(key, PipelineLibraryPart::PRE_RASTERIZATION, renderPass);
+					job.parts[2] = GetOrCreateLibrary(key, PipelineLibraryPart::FRAGMENT_SHADER, renderPass);
+					job.parts[3] = GetOrCreateLibrary(key, PipelineLibraryPart::FRAGMENT_OUTPUT, renderPass);
+				}
+
+				job.fastPipeline = LinkPipeline(job.parts, key.pipelineLayout, false);
+
+				if (job.fastPipeline == VK_NULL_HANDLE)
+				{
+					Logger_WriteConsole("Failed to fast-link graphics pipeline, falling back to a monolithic pipeline", LogLevel::WARNING);
+					return CreatePipeline(key, renderPass);
+				}
+
+				return job.fastPipeline;
+			}
+
+			void RunLinkJobs()
+			{
+				while (true)
+				{
+					LinkJob job;
+
+					{
+						UniqueLock lock(linkMutex);
+
+						linkAvailable.wait(lock, [this] { return isStopping || !pendingLinks.empty(); });
+
+						if (isStopping)
+							return;
+
+						job = pendingLinks.front();
+						pendingLinks.pop_front();
+
+						isLinking = true;
+					}
+
+					VkPipeline optimizedPipeline = LinkPipeline(job.parts, job.pipelineLayout, true);
+
+					{
+						LockGuard<Mutex> lock(linkMutex);
+
+						if (optimizedPipeline != VK_NULL_HANDLE)
+							completedLinks.push_back({ job.slot, job.fastPipeline, optimizedPipeline });
+
+						isLinking = false;
+					}
+
+					linkFinished.notify_all();
+
+					if (optimizedPipeline == VK_NULL_HANDLE)
+						Logger_WriteConsole("Failed to create link-time optimized pipeline, keeping the fast-linked pipeline", LogLevel::WARNING);
+				}
+			}
+
+			VkDevice device = VK_NULL_HANDLE;
+			bool isLibrarySupported = false;
+
+			Mutex mutex;
+			Mutex libraryMutex;
+
+			UnorderedMap<ullong, Vector<Pair<PipelineStateKey, PipelineSlot>>> pipelines;
+			Array<UnorderedMap<ullong, Vector<Pair<PipelineStateKey, VkPipeline>>>, 4> libraries;
+			UnorderedMap<VkRenderPass, ullong> renderPassCompatibilities;
+
+			Mutex linkMutex;
+			ConditionVariable linkAvailable;
+			ConditionVariable linkFinished;
+			Thread linkThread;
+			bool isStopping = false;
+			bool isLinking = false;
+
+			List<LinkJob> pendingLinks;
+			Vector<LinkResult> completedLinks;
+
+			Atomic<Size> hitCount = 0;
+			Atomic<Size> missCount = 0;
+			Atomic<Size> replacementCount = 0;
+
+		};
+	}
+}
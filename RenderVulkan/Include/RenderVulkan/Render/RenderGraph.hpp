@@ -0,0 +1,913 @@
+#pragma once
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Core/Settings.hpp"
+#include "RenderVulkan/Render/ChangeTracker.hpp"
+#include "RenderVulkan/Render/GpuProfiler.hpp"
+#include "RenderVulkan/Render/PipelineStateCache.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+#include "RenderVulkan/Util/VulkanHelper.hpp"
+
+using namespace RenderVulkan::Core;
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		typedef uint RenderGraphResource;
+		typedef uint RenderGraphPass;
+
+		enum class RenderGraphAccess
+		{
+			COLOR_WRITE,
+			COLOR_RESOLVE,
+			DEPTH_WRITE,
+			DEPTH_READ,
+			TEXTURE_READ
+		};
+
+		struct RenderGraphImageDescription
+		{
+			VkFormat format = VK_FORMAT_UNDEFINED;
+			VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+			float scale = 1.0f;
+		};
+
+		struct RenderGraphPassContext
+		{
+			VkRenderPass renderPass = VK_NULL_HANDLE;
+			VkFramebuffer framebuffer = VK_NULL_HANDLE;
+			VkExtent2D extent = {};
+			uint imageIndex = 0;
+		};
+
+		class RenderGraph;
+
+		class RenderGraphBuilder
+		{
+
+		public:
+
+			void WriteColor(RenderGraphResource resource, Optional<VkClearColorValue> clearValue = {})
+			{
+				Optional<VkClearValue> value;
+
+				if (clearValue.has_value())
+				{
+					value = VkClearValue{};
+					value->color = clearValue.value();
+				}
+
+				usages.push_back({ resource, RenderGraphAccess::COLOR_WRITE, value });
+			}
+
+			void WriteDepth(RenderGraphResource resource, Optional<VkClearDepthStencilValue> clearValue = {})
+			{
+				Optional<VkClearValue> value;
+
+				if (clearValue.has_value())
+				{
+					value = VkClearValue{};
+					value->depthStencil = clearValue.value();
+				}
+
+				usages.push_back({ resource, RenderGraphAccess::DEPTH_WRITE, value });
+			}
+
+			void ResolveColor(RenderGraphResource source, RenderGraphResource destination)
+			{
+				usages.push_back({ destination, RenderGraphAccess::COLOR_RESOLVE, {}, source });
+			}
+
+			void ReadDepth(RenderGraphResource resource)
+			{
+				usages.push_back({ resource, RenderGraphAccess::DEPTH_READ, {} });
+			}
+
+			void ReadTexture(RenderGraphResource resource)
+			{
+				usages.push_back({ resource, RenderGraphAccess::TEXTURE_READ, {} });
+			}
+
+			void UseSecondaryCommandBuffers(bool value = true)
+			{
+				usesSecondaryCommandBuffers = value;
+			}
+
+			void SetSideEffect(bool value = true)
+			{
+				hasSideEffect = value;
+			}
+
+		private:
+
+			friend class RenderGraph;
+
+			struct Usage
+			{
+				RenderGraphResource resource;
+				RenderGraphAccess access;
+				Optional<VkClearValue> clearValue;
+				RenderGraphResource source = 0;
+			};
+
+			Vector<Usage> usages;
+			bool usesSecondaryCommandBuffers = false;
+			bool hasSideEffect = false;
+
+		};
+
+		class RenderGraph
+		{
+
+		public:
+
+			RenderGraph(const RenderGraph&) = delete;
+			RenderGraph& operator=(const RenderGraph&) = delete;
+
+			RenderGraphResource ImportImage(const String& name, VkFormat format, const Vector<VkImage>& images, const Vector<VkImageView>& imageViews, VkImageLayout finalLayout)
+			{
+				ResourceEntry resource = {};
+
+				resource.name = name;
+				resource.isImported = true;
+				resource.description.format = format;
+				resource.importedImages = images;
+				resource.importedImageViews = imageViews;
+				resource.importedFinalLayout = finalLayout;
+
+				resources.push_back(resource);
+
+				return static_cast<RenderGraphResource>(resources.size() - 1);
+			}
+
+			RenderGraphResource CreateImage(const String& name, const RenderGraphImageDescription& description)
+			{
+				ResourceEntry resource = {};
+
+				resource.name = name;
+				resource.description = description;
+
+				resources.push_back(resource);
+
+				return static_cast<RenderGraphResource>(resources.size() - 1);
+			}
+
+			RenderGraphPass AddPass(const String& name, const Function<void(RenderGraphBuilder&)>& setup, const Function<void(VkCommandBuffer, const RenderGraphPassContext&)>& execute)
+			{
+				PassEntry pass = {};
+
+				pass.name = name;
+				pass.execute = execute;
+
+				setup(pass.builder);
+
+				passes.push_back(std::move(pass));
+
+				return static_cast<RenderGraphPass>(passes.size() - 1);
+			}
+
+			void Compile(VkExtent2D extent)
+			{
+				device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
+				outputExtent = extent;
+
+				CullPasses();
+				ComputeLifetimes();
+				CreateTransientImages();
+				CreateRenderPasses();
+				CreateFramebuffers();
+
+				isCompiled = true;
+
+				Size livePassCount = std::count_if(passes.begin(), passes.end(), [](const PassEntry& pass) { return !pass.isCulled; });
+
+				Logger_WriteConsole(Formatter::Format("Render graph compiled; '{}' of '{}' passes live, '{}' KiB of transient memory ('{}' KiB before aliasing)", livePassCount, passes.size(), aliasedMemorySize / 1024, transientMemorySize / 1024), LogLevel::INFORMATION);
+
+				ChangeTracker::GetInstance()->Invalidate();
+			}
+
+			void Execute(VkCommandBuffer commandBuffer, uint imageIndex)
+			{
+				for (PassEntry& pass : passes)
+				{
+					if (pass.isCulled)
+						continue;
+
+					GpuZone zone(commandBuffer, pass.name);
+
+					if (!pass.barriers.empty())
+					{
+						Vector<VkImageMemoryBarrier> barriers = pass.barriers;
+
+						for (Size b = 0; b < barriers.size(); b++)
+							barriers[b].image = GetImage(pass.barrierResources[b], imageIndex);
+
+						vkCmdPipelineBarrier(commandBuffer, pass.barrierSrcStageMask, pass.barrierDstStageMask, 0, 0, nullptr, 0, nullptr, static_cast<uint>(barriers.size()), barriers.data());
+					}
+
+					RenderGraphPassContext context = {};
+
+					context.renderPass = pass.renderPass;
+					context.framebuffer = pass.framebuffers[std::min<Size>(imageIndex, pass.framebuffers.size() - 1)];
+					context.extent = pass.extent;
+					context.imageIndex = imageIndex;
+
+					VkRenderPassBeginInfo beginInformation = {};
+
+					beginInformation.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+					beginInformation.renderPass = context.renderPass;
+					beginInformation.framebuffer = context.framebuffer;
+					beginInformation.renderArea.offset = { 0, 0 };
+					beginInformation.renderArea.extent = context.extent;
+					beginInformation.clearValueCount = static_cast<uint>(pass.clearValues.size());
+					beginInformation.pClearValues = pass.clearValues.data();
+
+					vkCmdBeginRenderPass(commandBuffer, &beginInformation, pass.builder.usesSecondaryCommandBuffers ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+
+					pass.execute(commandBuffer, context);
+
+					vkCmdEndRenderPass(commandBuffer);
+				}
+			}
+
+			VkRenderPass GetRenderPass(RenderGraphPass pass) const
+			{
+				return passes[pass].renderPass;
+			}
+
+			void SetSecondaryCommandBuffers(RenderGraphPass pass, bool value)
+			{
+				passes[pass].builder.usesSecondaryCommandBuffers = value;
+			}
+
+			VkExtent2D GetExtent(RenderGraphResource resource) const
+			{
+				return ScaleExtent(resources[resource].description.scale);
+			}
+
+			VkImageView GetImageView(RenderGraphResource resource, uint imageIndex = 0) const
+			{
+				const ResourceEntry& entry = resources[resource];
+
+				if (entry.isImported)
+					return entry.importedImageViews[std::min<Size>(imageIndex, entry.importedImageViews.size() - 1)];
+
+				return entry.imageView;
+			}
+
+			bool IsCulled(RenderGraphPass pass) const
+			{
+				return passes[pass].isCulled;
+			}
+
+			bool IsCompiled() const
+			{
+				return isCompiled;
+			}
+
+			VkDeviceSize GetTransientMemorySize() const
+			{
+				return transientMemorySize;
+			}
+
+			VkDeviceSize GetAliasedMemorySize() const
+			{
+				return aliasedMemorySize;
+			}
+
+			void CleanUp()
+			{
+				for (PassEntry& pass : passes)
+				{
+					for (VkFramebuffer framebuffer : pass.framebuffers)
+						vkDestroyFramebuffer(device, framebuffer, nullptr);
+
+					if (pass.renderPass != VK_NULL_HANDLE)
+					{
+						PipelineStateCache::GetInstance()->UnregisterRenderPass(pass.renderPass);
+						vkDestroyRenderPass(device, pass.renderPass, nullptr);
+					}
+
+					pass.framebuffers.clear();
+					pass.renderPass = VK_NULL_HANDLE;
+				}
+
+				for (ResourceEntry& resource : resources)
+				{
+					if (resource.imageView != VK_NULL_HANDLE)
+						vkDestroyImageView(device, resource.imageView, nullptr);
+
+					if (resource.image != VK_NULL_HANDLE)
+						vkDestroyImage(device, resource.image, nullptr);
+
+					resource.imageView = VK_NULL_HANDLE;
+					resource.image = VK_NULL_HANDLE;
+				}
+
+				for (VkDeviceMemory memory : memoryBlocks)
+					vkFreeMemory(device, memory, nullptr);
+
+				memoryBlocks.clear();
+
+				isCompiled = false;
+			}
+
+			static Unique<RenderGraph> Create()
+			{
+				class EnabledRenderGraph : public RenderGraph { };
+
+				return std::make_unique<EnabledRenderGraph>();
+			}
+
+		private:
+
+			struct AccessState
+			{
+				VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+				VkPipelineStageFlags stageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+				VkAccessFlags accessMask = 0;
+			};
+
+			struct ResourceEntry
+			{
+				String name;
+				RenderGraphImageDescription description;
+
+				bool isImported = false;
+				Vector<VkImage> importedImages;
+				Vector<VkImageView> importedImageViews;
+				VkImageLayout importedFinalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+				VkImageUsageFlags usage = 0;
+				bool isSampled = false;
+				bool isLazilyAllocated = false;
+
+				int firstPass = -1;
+				int lastPass = -1;
+
+				VkImage image = VK_NULL_HANDLE;
+				VkImageView imageView = VK_NULL_HANDLE;
+			};
+
+			struct PassEntry
+			{
+				String name;
+				RenderGraphBuilder builder;
+				Function<void(VkCommandBuffer, const RenderGraphPassContext&)> execute;
+
+				bool isCulled = false;
+
+				VkRenderPass renderPass = VK_NULL_HANDLE;
+				Vector<VkFramebuffer> framebuffers;
+				Vector<RenderGraphResource> attachments;
+				Vector<VkClearValue> clearValues;
+				VkExtent2D extent = {};
+
+				Vector<VkImageMemoryBarrier> barriers;
+				Vector<RenderGraphResource> barrierResources;
+				VkPipelineStageFlags barrierSrcStageMask = 0;
+				VkPipelineStageFlags barrierDstStageMask = 0;
+			};
+
+			RenderGraph() = default;
+
+			static bool IsAttachment(RenderGraphAccess access)
+			{
+				return access != RenderGraphAccess::TEXTURE_READ;
+			}
+
+			static bool IsWrite(RenderGraphAccess access)
+			{
+				return access == RenderGraphAccess::COLOR_WRITE || access == RenderGraphAccess::COLOR_RESOLVE || access == RenderGraphAccess::DEPTH_WRITE;
+			}
+
+			static bool IsOverwrite(const RenderGraphBuilder::Usage& usage)
+			{
+				return usage.access == RenderGraphAccess::COLOR_RESOLVE || (IsWrite(usage.access) && usage.clearValue.has_value());
+			}
+
+			static bool IsDepthFormat(VkFormat format)
+			{
+				return format == VK_FORMAT_D16_UNORM || format == VK_FORMAT_X8_D24_UNORM_PACK32 || format == VK_FORMAT_D32_SFLOAT || format == VK_FORMAT_D16_UNORM_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT || format == VK_FORMAT_D32_SFLOAT_S8_UINT;
+			}
+
+			static bool HasStencil(VkFormat format)
+			{
+				return format == VK_FORMAT_D16_UNORM_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT || format == VK_FORMAT_D32_SFLOAT_S8_UINT;
+			}
+
+			static AccessState GetAccessState(RenderGraphAccess access)
+			{
+				switch (access)
+				{
+
+				case RenderGraphAccess::COLOR_WRITE:
+				case RenderGraphAccess::COLOR_RESOLVE:
+					return { VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT };
+
+				case RenderGraphAccess::DEPTH_WRITE:
+					return { VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT };
+
+				case RenderGraphAccess::DEPTH_READ:
+					return { VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT };
+
+				case RenderGraphAccess::TEXTURE_READ:
+					return { VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT };
+
+				default:
+					return {};
+				}
+			}
+
+			VkExtent2D ScaleExtent(float scale) const
+			{
+				return { std::max(1u, static_cast<uint>(outputExtent.width * scale)), std::max(1u, static_cast<uint>(outputExtent.height * scale)) };
+			}
+
+			VkImage GetImage(RenderGraphResource resource, uint imageIndex) const
+			{
+				const ResourceEntry& entry = resources[resource];
+
+				if (entry.isImported)
+					return entry.importedImages[std::min<Size>(imageIndex, entry.importedImages.size() - 1)];
+
+				return entry.image;
+			}
+
+			void CullPasses()
+			{
+				Set<RenderGraphResource> neededResources;
+
+				for (RenderGraphResource r = 0; r < resources.size(); r++)
+				{
+					if (resources[r].isImported)
+						neededResources.insert(r);
+				}
+
+				for (int p = static_cast<int>(passes.size()) - 1; p >= 0; p--)
+				{
+					PassEntry& pass = passes[p];
+
+					bool isLive = pass.builder.hasSideEffect;
+
+					for (const auto& usage : pass.builder.usages)
+					{
+						if (IsWrite(usage.access) && neededResources.contains(usage.resource))
+							isLive = true;
+					}
+
+					pass.isCulled = !isLive;
+
+					if (!isLive)
+						continue;
+
+					for (const auto& usage : pass.builder.usages)
+					{
+						if (IsOverwrite(usage))
+							neededResources.erase(usage.resource);
+					}
+
+					for (const auto& usage : pass.builder.usages)
+					{
+						if (!IsOverwrite(usage))
+							neededResources.insert(usage.resource);
+					}
+				}
+			}
+
+			void ComputeLifetimes()
+			{
+				for (ResourceEntry& resource : resources)
+				{
+					resource.firstPass = -1;
+					resource.lastPass = -1;
+					resource.usage = 0;
+					resource.isSampled = false;
+				}
+
+				for (int p = 0; p < static_cast<int>(passes.size()); p++)
+				{
+					if (passes[p].isCulled)
+						continue;
+
+					for (const auto& usage : passes[p].builder.usages)
+					{
+						ResourceEntry& resource = resources[usage.resource];
+
+						if (resource.firstPass < 0)
+							resource.firstPass = p;
+
+						resource.lastPass = p;
+
+						if (usage.access == RenderGraphAccess::COLOR_WRITE || usage.access == RenderGraphAccess::COLOR_RESOLVE)
+							resource.usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+						else if (usage.access == RenderGraphAccess::TEXTURE_READ)
+						{
+							resource.usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+							resource.isSampled = true;
+						}
+						else
+							resource.usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+					}
+				}
+
+				for (ResourceEntry& resource : resources)
+				{
+					resource.isLazilyAllocated = !resource.isImported && resource.firstPass >= 0 && resource.firstPass == resource.lastPass && !resource.isSampled;
+
+					if (resource.isLazilyAllocated)
+						resource.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+				}
+			}
+
+			void CreateTransientImages()
+			{
+				struct AliasSlot
+				{
+					VkDeviceSize size = 0;
+					VkDeviceSize alignment = 1;
+					uint memoryTypeBits = NumericLimits<uint>::max();
+					Vector<Pair<int, int>> lifetimes;
+					Vector<RenderGraphResource> resources;
+				};
+
+				Vector<RenderGraphResource> transients;
+				Vector<VkMemoryRequirements> requirements(resources.size());
+
+				transientMemorySize = 0;
+				aliasedMemorySize = 0;
+
+				for (RenderGraphResource r = 0; r < resources.size(); r++)
+				{
+					ResourceEntry& resource = resources[r];
+
+					if (resource.isImported || resource.firstPass < 0)
+						continue;
+
+					VkExtent2D extent = ScaleExtent(resource.description.scale);
+
+					VkImageCreateInfo imageInformation = {};
+
+					imageInformation.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+					imageInformation.imageType = VK_IMAGE_TYPE_2D;
+					imageInformation.format = resource.description.format;
+					imageInformation.extent = { extent.width, extent.height, 1 };
+					imageInformation.mipLevels = 1;
+					imageInformation.arrayLayers = 1;
+					imageInformation.samples = resource.description.samples;
+					imageInformation.tiling = VK_IMAGE_TILING_OPTIMAL;
+					imageInformation.usage = resource.usage;
+					imageInformation.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+					imageInformation.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+					VkResult result = vkCreateImage(device, &imageInformation, nullptr, &resource.image);
+					Logger_ThrowIfFailed(result, Formatter::Format("Failed to create render graph image '{}'", resource.name), true);
+
+					vkGetImageMemoryRequirements(device, resource.image, &requirements[r]);
+
+					transientMemorySize += requirements[r].size;
+					transients.push_back(r);
+				}
+
+				std::sort(transients.begin(), transients.end(), [&requirements](RenderGraphResource a, RenderGraphResource b) { return requirements[a].size > requirements[b].size; });
+
+				Vector<AliasSlot> slots;
+
+				for (RenderGraphResource r : transients)
+				{
+					const ResourceEntry& resource = resources[r];
+					AliasSlot* target = nullptr;
+
+					if (!resource.isLazilyAllocated)
+					{
+						for (AliasSlot& slot : slots)
+						{
+							if (resources[slot.resources.front()].isLazilyAllocated || (slot.memoryTypeBits & requirements[r].memoryTypeBits) == 0)
+								continue;
+
+							bool overlaps = std::any_of(slot.lifetimes.begin(), slot.lifetimes.end(), [&resource](const Pair<int, int>& lifetime) { return resource.firstPass <= lifetime.second && lifetime.first <= resource.lastPass; });
+
+							if (!overlaps)
+							{
+								target = &slot;
+								break;
+							}
+						}
+					}
+
+					if (target == nullptr)
+					{
+						slots.push_back({});
+						target = &slots.back();
+					}
+
+					target->size = std::max(target->size, requirements[r].size);
+					target->alignment = std::max(target->alignment, requirements[r].alignment);
+					target->memoryTypeBits &= requirements[r].memoryTypeBits;
+					target->lifetimes.push_back({ resource.firstPass, resource.lastPass });
+					target->resources.push_back(r);
+				}
+
+				for (const AliasSlot& slot : slots)
+				{
+					bool isLazilyAllocated = resources[slot.resources.front()].isLazilyAllocated;
+
+					VkMemoryAllocateInfo allocationInformation = {};
+
+					allocationInformation.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+					allocationInformation.allocationSize = slot.size;
+					allocationInformation.memoryTypeIndex = FindMemoryType(slot.memoryTypeBits, isLazilyAllocated);
+
+					VkDeviceMemory memory;
+
+					VkResult result = vkAllocateMemory(device, &allocationInformation, nullptr, &memory);
+					Logger_ThrowIfFailed(result, "Failed to allocate render graph memory", true);
+
+					memoryBlocks.push_back(memory);
+					aliasedMemorySize += slot.size;
+
+					for (RenderGraphResource r : slot.resources)
+					{
+						ResourceEntry& resource = resources[r];
+
+						vkBindImageMemory(device, resource.image, memory, 0);
+
+						bool isDepth = IsDepthFormat(resource.description.format);
+
+						VkImageViewCreateInfo viewInformation = {};
+
+						viewInformation.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+						viewInformation.image = resource.image;
+						viewInformation.viewType = VK_IMAGE_VIEW_TYPE_2D;
+						viewInformation.format = resource.description.format;
+						viewInformation.subresourceRange.aspectMask = isDepth ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+						viewInformation.subresourceRange.baseMipLevel = 0;
+						viewInformation.subresourceRange.levelCount = 1;
+						viewInformation.subresourceRange.baseArrayLayer = 0;
+						viewInformation.subresourceRange.layerCount = 1;
+
+						result = vkCreateImageView(device, &viewInformation, nullptr, &resource.imageView);
+						Logger_ThrowIfFailed(result, Formatter::Format("Failed to create render graph image view '{}'", resource.name), true);
+					}
+				}
+			}
+
+			uint FindMemoryType(uint typeFilter, bool preferLazilyAllocated)
+			{
+				if (preferLazilyAllocated)
+				{
+					VkPhysicalDevice physicalDevice = Settings::GetInstance()->GetPointer<VkPhysicalDevice>("physicalDevice");
+					VkPhysicalDeviceMemoryProperties memoryProperties;
+
+					vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+					for (uint i = 0; i < memoryProperties.memoryTypeCount; i++)
+					{
+						VkMemoryPropertyFlags flags = memoryProperties.memoryTypes[i].propertyFlags;
+
+						if ((typeFilter & (1 << i)) && (flags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) && (flags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT))
+							return i;
+					}
+				}
+
+				return VulkanHelper::FindMemoryType(typeFilter, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+			}
+
+			void CreateRenderPasses()
+			{
+				Vector<AccessState> states(resources.size());
+				Vector<bool> hasContents(resources.size(), false);
+
+				for (int p = 0; p < static_cast<int>(passes.size()); p++)
+				{
+					PassEntry& pass = passes[p];
+
+					if (pass.isCulled)
+						continue;
+
+					pass.barriers.clear();
+					pass.barrierResources.clear();
+					pass.barrierSrcStageMask = 0;
+					pass.barrierDstStageMask = 0;
+					pass.attachments.clear();
+					pass.clearValues.clear();
+
+					Vector<VkAttachmentDescription> attachmentDescriptions;
+					Vector<VkAttachmentReference> colorReferences;
+					Vector<RenderGraphResource> colorResources;
+					Vector<Pair<RenderGraphResource, VkAttachmentReference>> resolves;
+					Optional<VkAttachmentReference> depthReference;
+
+					for (const auto& usage : pass.builder.usages)
+					{
+						ResourceEntry& resource = resources[usage.resource];
+						AccessState state = GetAccessState(usage.access);
+						AccessState& current = states[usage.resource];
+
+						if (!IsAttachment(usage.access))
+						{
+							if (current.layout != state.layout || (current.accessMask & (VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT)))
+								AddBarrier(pass, usage.resource, current, state);
+
+							current = state;
+							continue;
+						}
+
+						bool isLoaded = !IsOverwrite(usage) && hasContents[usage.resource];
+						bool isUsedLater = resource.isImported || resource.lastPass > p;
+						bool isDepth = IsDepthFormat(resource.description.format);
+
+						VkAttachmentDescription attachment = {};
+
+						attachment.format = resource.description.format;
+						attachment.samples = resource.description.samples;
+						attachment.loadOp = usage.clearValue.has_value() ? VK_ATTACHMENT_LOAD_OP_CLEAR : (isLoaded ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE);
+						attachment.storeOp = isUsedLater ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+						attachment.stencilLoadOp = isDepth && HasStencil(resource.description.format) ? attachment.loadOp : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+						attachment.stencilStoreOp = isDepth && HasStencil(resource.description.format) ? attachment.storeOp : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+						attachment.initialLayout = isLoaded ? current.layout : VK_IMAGE_LAYOUT_UNDEFINED;
+						attachment.finalLayout = resource.isImported && resource.lastPass == p ? resource.importedFinalLayout : state.layout;
+
+						VkAttachmentReference reference = {};
+
+						reference.attachment = static_cast<uint>(attachmentDescriptions.size());
+						reference.layout = state.layout;
+
+						if (usage.access == RenderGraphAccess::COLOR_RESOLVE)
+							resolves.push_back({ usage.source, reference });
+						else if (isDepth)
+							depthReference = reference;
+						else
+						{
+							colorReferences.push_back(reference);
+							colorResources.push_back(usage.resource);
+						}
+
+						attachmentDescriptions.push_back(attachment);
+						pass.attachments.push_back(usage.resource);
+						pass.clearValues.push_back(usage.clearValue.value_or(VkClearValue{}));
+						pass.extent = ScaleExtent(resource.description.scale);
+
+						current = state;
+						current.layout = attachment.finalLayout;
+
+						if (IsWrite(usage.access))
+							hasContents[usage.resource] = true;
+					}
+
+					Vector<VkAttachmentReference> resolveReferences;
+
+					if (!resolves.empty())
+					{
+						resolveReferences.assign(colorReferences.size(), { VK_ATTACHMENT_UNUSED, VK_IMAGE_LAYOUT_UNDEFINED });
+
+						for (const auto& [source, reference] : resolves)
+						{
+							auto iterator = std::find(colorResources.begin(), colorResources.end(), source);
+
+							if (iterator == colorResources.end())
+								Logger_ThrowException(Formatter::Format("Pass '{}' resolves '{}' without writing it as a color attachment", pass.name, resources[source].name), true);
+
+							resolveReferences[iterator - colorResources.begin()] = reference;
+						}
+					}
+
+					VkSubpassDescription subpass = {};
+
+					subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+					subpass.colorAttachmentCount = static_cast<uint>(colorReferences.size());
+					subpass.pColorAttachments = colorReferences.data();
+					subpass.pResolveAttachments = resolveReferences.empty() ? nullptr : resolveReferences.data();
+					subpass.pDepthStencilAttachment = depthReference.has_value() ? &depthReference.value() : nullptr;
+
+					VkSubpassDependency dependency = {};
+
+					dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+					dependency.dstSubpass = 0;
+					dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+					dependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+					dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+					dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+					VkRenderPassCreateInfo renderPassInformation = {};
+
+					renderPassInformation.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+					renderPassInformation.attachmentCount = static_cast<uint>(attachmentDescriptions.size());
+					renderPassInformation.pAttachments = attachmentDescriptions.data();
+					renderPassInformation.subpassCount = 1;
+					renderPassInformation.pSubpasses = &subpass;
+					renderPassInformation.dependencyCount = 1;
+					renderPassInformation.pDependencies = &dependency;
+
+					VkResult result = vkCreateRenderPass(device, &renderPassInformation, nullptr, &pass.renderPass);
+					Logger_ThrowIfFailed(result, Formatter::Format("Failed to create render pass '{}'", pass.name), true);
+
+					PipelineStateCache::GetInstance()->RegisterRenderPass(pass.renderPass, HashCompatibility(attachmentDescriptions, subpass));
+				}
+			}
+
+			static ullong HashCompatibility(const Vector<VkAttachmentDescription>& attachments, const VkSubpassDescription& subpass)
+			{
+				Vector<uint> values = { subpass.colorAttachmentCount, subpass.pResolveAttachments != nullptr, subpass.pDepthStencilAttachment != nullptr };
+
+				for (const VkAttachmentDescription& attachment : attachments)
+				{
+					values.push_back(attachment.format);
+					values.push_back(attachment.samples);
+				}
+
+				ullong hash = 14695981039346656037ull;
+
+				for (uint value : values)
+				{
+					hash ^= value;
+					hash *= 1099511628211ull;
+				}
+
+				return hash;
+			}
+
+			void AddBarrier(PassEntry& pass, RenderGraphResource resource, const AccessState& current, const AccessState& next)
+			{
+				bool isDepth = IsDepthFormat(resources[resource].description.format);
+
+				VkImageMemoryBarrier barrier = {};
+
+				barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+				barrier.oldLayout = current.layout;
+				barrier.newLayout = next.layout;
+				barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				barrier.srcAccessMask = current.accessMask & (VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+				barrier.dstAccessMask = next.accessMask;
+				barrier.subresourceRange.aspectMask = isDepth ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+				barrier.subresourceRange.baseMipLevel = 0;
+				barrier.subresourceRange.levelCount = 1;
+				barrier.subresourceRange.baseArrayLayer = 0;
+				barrier.subresourceRange.layerCount = 1;
+
+				pass.barriers.push_back(barrier);
+				pass.barrierResources.push_back(resource);
+				pass.barrierSrcStageMask |= current.stageMask;
+				pass.barrierDstStageMask |= next.stageMask;
+			}
+
+			void CreateFramebuffers()
+			{
+				for (PassEntry& pass : passes)
+				{
+					if (pass.isCulled)
+						continue;
+
+					Size framebufferCount = 1;
+
+					for (RenderGraphResource resource : pass.attachments)
+					{
+						if (resources[resource].isImported)
+							framebufferCount = std::max(framebufferCount, resources[resource].importedImageViews.size());
+					}
+
+					pass.framebuffers.resize(framebufferCount);
+
+					for (Size f = 0; f < framebufferCount; f++)
+					{
+						Vector<VkImageView> attachments;
+
+						for (RenderGraphResource resource : pass.attachments)
+							attachments.push_back(GetImageView(resource, static_cast<uint>(f)));
+
+						VkFramebufferCreateInfo framebufferInformation = {};
+
+						framebufferInformation.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+						framebufferInformation.renderPass = pass.renderPass;
+						framebufferInformation.attachmentCount = static_cast<uint>(attachments.size());
+						framebufferInformation.pAttachments = attachments.data();
+						framebufferInformation.width = pass.extent.width;
+						framebufferInformation.height = pass.extent.height;
+						framebufferInformation.layers = 1;
+
+						VkResult result = vkCreateFramebuffer(device, &framebufferInformation, nullptr, &pass.framebuffers[f]);
+						Logger_ThrowIfFailed(result, Formatter::Format("Failed to create framebuffer for pass '{}'", pass.name), true);
+					}
+				}
+			}
+
+			VkDevice device = VK_NULL_HANDLE;
+			VkExtent2D outputExtent = {};
+
+			Vector<ResourceEntry> resources;
+			Vector<PassEntry> passes;
+
+			Vector<VkDeviceMemory> memoryBlocks;
+			VkDeviceSize transientMemorySize = 0;
+			VkDeviceSize aliasedMemorySize = 0;
+
+			bool isCompiled = false;
+
+		};
+	}
+}
@@ -6,11 +6,30 @@
 #define GLFW_EXPOSE_NATIVE_WIN32
 #include <GLFW/glfw3native.h>
 #include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Core/Profiler.hpp"
 #include "RenderVulkan/Core/Window.hpp"
+#include "RenderVulkan/ECS/Component.hpp"
+#include "RenderVulkan/Render/BindlessManager.hpp"
+#include "RenderVulkan/Render/ChangeTracker.hpp"
+#include "RenderVulkan/Render/DescriptorSetCache.hpp"
+#include "RenderVulkan/Render/DeviceCapabilities.hpp"
+#include "RenderVulkan/Render/DynamicStateTracker.hpp"
+#include "RenderVulkan/Render/FrameContext.hpp"
+#include "RenderVulkan/Render/GpuProfiler.hpp"
+#include "RenderVulkan/Render/LayoutCache.hpp"
+#include "RenderVulkan/Render/PhysicalDeviceDatabase.hpp"
+#include "RenderVulkan/Render/PipelineCache.hpp"
+#include "RenderVulkan/Render/PipelineStateCache.hpp"
+#include "RenderVulkan/Render/RenderGraph.hpp"
+#include "RenderVulkan/Render/TimelineScheduler.hpp"
+#include "RenderVulkan/Render/UniformRingBuffer.hpp"
+#include "RenderVulkan/Render/UploadManager.hpp"
 #include "RenderVulkan/Util/DataHelper.hpp"
+#include "RenderVulkan/Util/ThreadPool.hpp"
 #include "RenderVulkan/Util/VulkanHelper.hpp"
 
 using namespace RenderVulkan::Core;
+using namespace RenderVulkan::ECS;
 using namespace RenderVulkan::Util;
 
 namespace RenderVulkan
@@ -32,75 +51,132 @@ namespace RenderVulkan
 
 				Logger_WriteConsole("Number of extensions supported: '" + std::to_string(extensionsCount) + "'", LogLevel::INFORMATION);
 
+				isHeadless = Settings::GetInstance()->Get<bool>("headless");
+
+				if (Settings::GetInstance()->Get<uint>("framesInFlight") > 0)
+					framesInFlight = Settings::GetInstance()->Get<uint>("framesInFlight");
+
+				recordingThreadCount = Settings::GetInstance()->Get<uint>("recordingThreads");
+				isCommandBufferCachingEnabled = Settings::GetInstance()->Get<bool>("commandBufferCaching");
+				isDepthPrepassEnabled = Settings::GetInstance()->Get<bool>("depthPrepass");
+
+				if (recordingThreadCount > 0)
+					recordingThreadPool = ThreadPool::Create(recordingThreadCount);
+
+				if (isHeadless)
+				{
+					deviceExtensions.erase(std::remove_if(deviceExtensions.begin(), deviceExtensions.end(), [](const char* extension) { return strcmp(extension, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0; }), deviceExtensions.end());
+
+					Logger_WriteConsole("Running in headless mode", LogLevel::INFORMATION);
+				}
+
 				CreateInstance();
 				SetupDebugMessenger();
-				CreateWindowSurface();
+
+				if (!isHeadless)
+					CreateWindowSurface();
+
 				CreatePhysicalDevice();
 				CreateLogicalDevice();
-				CreateCommandPool();
-				CreateSwapChain();
-				CreateImageViews();
-				CreateRenderPass();
-				CreateFramebuffers();
-				CreateCommandBuffers();
-				CreateSyncObjects();
 
 				Settings::GetInstance()->SetPointer<VkInstance>("vulkanInstance", instance);
 				Settings::GetInstance()->SetPointer<VkDevice>("logicalDevice", device);
 				Settings::GetInstance()->SetPointer<VkPhysicalDevice>("physicalDevice", physicalDevice);
 				Settings::GetInstance()->SetPointer<VkQueue>("graphicsQueue", graphicsQueue);
 				Settings::GetInstance()->SetPointer<VkQueue>("presentQueue", presentQueue);
+				Settings::GetInstance()->SetPointer<VkQueue>("transferQueue", transferQueue);
+				Settings::GetInstance()->Set<uint>("graphicsQueueFamily", deviceQueueFamilies.graphicsFamily.value());
+				Settings::GetInstance()->Set<uint>("transferQueueFamily", transferQueueFamily.value_or(deviceQueueFamilies.graphicsFamily.value()));
 				Settings::GetInstance()->SetPointer<VkSurfaceKHR>("surface", surface);
-				Settings::GetInstance()->SetPointer<VkCommandPool>("commandPool", commandPool);
+				Settings::GetInstance()->Set<DeviceCapabilities>("deviceCapabilities", deviceCapabilities);
+
+				depthFormat = VulkanHelper::FindDepthFormat(physicalDevice);
+				Settings::GetInstance()->Set<VkFormat>("depthFormat", depthFormat);
+
+				sampleCount = ChooseSampleCount(Settings::GetInstance()->Get<uint>("msaaSamples"));
+				Settings::GetInstance()->Set<VkSampleCountFlagBits>("sampleCount", sampleCount);
+
+				Component::SetChangeListener([] { ChangeTracker::GetInstance()->Invalidate(); });
+
+				TimelineScheduler::GetInstance()->Initialize();
+				UploadManager::GetInstance()->Initialize();
+				PipelineCache::GetInstance()->Initialize(Settings::GetInstance()->Get<String>("pipelineCachePath"));
+				PipelineStateCache::GetInstance()->Initialize();
+				DynamicStateTracker::GetInstance()->Initialize();
+				BindlessManager::GetInstance()->Initialize(framesInFlight);
+				UniformRingBuffer::GetInstance()->Initialize(framesInFlight);
+
+				if (isHeadless)
+					CreateOffscreenImages(Settings::GetInstance()->Get<Vector2i>("windowDimensions"));
+				else
+					CreateSwapChain();
+
+				CreateImageViews();
+				BuildRenderGraph();
+				CreateFrameContexts();
+
+				GpuProfiler::GetInstance()->Initialize(framesInFlight);
+
 				Settings::GetInstance()->Set<VkExtent2D>("swapChainExtent", swapChainExtent);
+
+				lastStatisticsTime = Clock::now();
 				
 				isInitalized = true;
 			}
 
 			void Render()
 			{
-				if (swapChainExtent.width <= 0 || swapChainExtent.height <= 0)
+				Profiler_Function();
+
+				if (isSwapChainRecreationPending && !RecreateSwapChain())
 					return;
 
-				vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
-				vkResetFences(device, 1, &inFlightFences[currentFrame]);
+				if (swapChainExtent.width <= 0 || swapChainExtent.height <= 0)
+					return;
 
-				uint imageIndex;
+				UploadManager::GetInstance()->Flush();
+				PipelineStateCache::GetInstance()->Update();
 
-				VkResult result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, imageAvailableSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
-				Logger_ThrowIfFailed(result, "Failed to acquire swap chain image", true);
+				if (isHeadless)
+				{
+					RenderOffscreen();
+					return;
+				}
 
-				vkResetCommandBuffer(commandBuffers[imageIndex], 0);
-				RecordCommandBuffer(commandBuffers[imageIndex], imageIndex);
+				FrameContext& frame = frameContexts[currentFrame];
 
-				VkSubmitInfo submitInfo = {};
-				submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+				WaitForFrame(frame);
 
-				VkSemaphore waitSemaphores[] = { imageAvailableSemaphores[currentFrame] };
+				uint imageIndex;
+				VkResult result;
 
-				VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+				{
+					Profiler_Scope("vkAcquireNextImageKHR");
 
-				submitInfo.waitSemaphoreCount = 1;
-				submitInfo.pWaitSemaphores = waitSemaphores;
-				submitInfo.pWaitDstStageMask = waitStages;
+					result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, frame.imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+				}
 
-				submitInfo.commandBufferCount = 1;
-				submitInfo.pCommandBuffers = &commandBuffers[imageIndex];
+				if (result == VK_ERROR_OUT_OF_DATE_KHR)
+				{
+					isSwapChainRecreationPending = true;
+					return;
+				}
 
-				VkSemaphore signalSemaphores[] = { renderFinishedSemaphores[currentFrame] };
+				if (result == VK_SUBOPTIMAL_KHR)
+					isSwapChainRecreationPending = true;
+				else
+					Logger_ThrowIfFailed(result, "Failed to acquire swap chain image", true);
 
-				submitInfo.signalSemaphoreCount = 1;
-				submitInfo.pSignalSemaphores = signalSemaphores;
+				PrepareFrameCommandBuffer(frame, imageIndex);
 
-				result = vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]);
-				Logger_ThrowIfFailed(result, "Failed to submit draw command buffer", true);
+				frame.timelineValue = TimelineScheduler::GetInstance()->Submit(graphicsQueue, { frame.commandBuffer }, { { frame.imageAvailableSemaphore, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT } }, { frame.renderFinishedSemaphore });
 
 				VkPresentInfoKHR presentInfo = {};
 
 				presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 
 				presentInfo.waitSemaphoreCount = 1;
-				presentInfo.pWaitSemaphores = signalSemaphores;
+				presentInfo.pWaitSemaphores = &frame.renderFinishedSemaphore;
 
 				VkSwapchainKHR swapChains[] = { swapChain };
 
@@ -108,22 +184,26 @@ namespace RenderVulkan
 				presentInfo.pSwapchains = swapChains;
 				presentInfo.pImageIndices = &imageIndex;
 
-				result = vkQueuePresentKHR(presentQueue, &presentInfo);
-				Logger_ThrowIfFailed(result, "Failed to present swap chain image", true);
+				{
+					Profiler_Scope("vkQueuePresentKHR");
+
+					result = vkQueuePresentKHR(presentQueue, &presentInfo);
+				}
+
+				if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+					isSwapChainRecreationPending = true;
+				else
+					Logger_ThrowIfFailed(result, "Failed to present swap chain image", true);
+
+				currentFrame = (currentFrame + 1) % framesInFlight;
 
-				currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+				UpdateFrameStatistics();
 			}
 
 			void Resize(const Vector2i& dimensions)
 			{
-				vkDeviceWaitIdle(device);
-
-				CleanUpSwapChain();
-
-				CreateSwapChain();
-				CreateImageViews();
-				CreateFramebuffers();
-				CreateCommandBuffers();
+				pendingDimensions = dimensions;
+				isSwapChainRecreationPending = true;
 			}
 
 			bool IsInitialized() const
@@ -131,6 +211,26 @@ namespace RenderVulkan
 				return isInitalized;
 			}
 
+			bool IsHeadless() const
+			{
+				return isHeadless;
+			}
+
+			const DeviceCapabilities& GetDeviceCapabilities() const
+			{
+				return deviceCapabilities;
+			}
+
+			float GetFramesPerSecond() const
+			{
+				return framesPerSecond;
+			}
+
+			ullong GetFrameCount() const
+			{
+				return totalFrameCount;
+			}
+
 			void AddValidationLayer(const String& layer)
 			{
 				validationLayers.push_back(layer.c_str());
@@ -144,6 +244,32 @@ namespace RenderVulkan
 			void SetRenderCallback(const Function<void(VkCommandBuffer, int)>& callback)
 			{
 				renderCallback = callback;
+
+				InvalidateCommandBuffers();
+			}
+
+			void SetDepthRenderCallback(const Function<void(VkCommandBuffer, int)>& callback)
+			{
+				depthRenderCallback = callback;
+
+				InvalidateCommandBuffers();
+			}
+
+			void SetParallelRenderCallback(const Function<void(VkCommandBuffer, Size, Size)>& callback)
+			{
+				parallelRenderCallback = callback;
+
+				InvalidateCommandBuffers();
+			}
+
+			void InvalidateCommandBuffers()
+			{
+				ChangeTracker::GetInstance()->Invalidate();
+			}
+
+			bool IsRecordingInParallel() const
+			{
+				return recordingThreadPool && parallelRenderCallback;
 			}
 
 			VkInstance GetVulkanInstance() const
@@ -183,17 +309,80 @@ namespace RenderVulkan
 
 			VkCommandBuffer GetCommandBuffer(Size index) const
 			{
-				return commandBuffers[index];
+				return frameContexts[index].commandBuffer;
 			}
 
 			VkCommandBuffer GetCommandBuffer() const
 			{
-				return commandBuffers[GetCurrentFrame()];
+				return frameContexts[GetCurrentFrame()].commandBuffer;
+			}
+
+			FrameContext& GetFrameContext(Size index)
+			{
+				return frameContexts[index];
+			}
+
+			FrameContext& GetFrameContext()
+			{
+				return frameContexts[GetCurrentFrame()];
 			}
 
 			VkRenderPass GetRenderPass() const
 			{
-				return renderPass;
+				return renderGraph->GetRenderPass(scenePass);
+			}
+
+			VkRenderPass GetDepthPrepassRenderPass() const
+			{
+				if (!isDepthPrepassEnabled)
+					return VK_NULL_HANDLE;
+
+				return renderGraph->GetRenderPass(depthPrepass);
+			}
+
+			bool IsDepthPrepassEnabled() const
+			{
+				return isDepthPrepassEnabled;
+			}
+
+			void SetSampleCount(uint samples)
+			{
+				VkSampleCountFlagBits chosenSampleCount = ChooseSampleCount(samples);
+
+				if (!isInitalized || chosenSampleCount == sampleCount)
+					return;
+
+				sampleCount = chosenSampleCount;
+				Settings::GetInstance()->Set<VkSampleCountFlagBits>("sampleCount", sampleCount);
+
+				Shared<RenderGraph> retiredRenderGraph = std::move(renderGraph);
+
+				TimelineScheduler::GetInstance()->OnLastSubmittedComplete([retiredRenderGraph]()
+				{
+					retiredRenderGraph->CleanUp();
+				});
+
+				BuildRenderGraph();
+			}
+
+			VkSampleCountFlagBits GetSampleCount() const
+			{
+				return sampleCount;
+			}
+
+			VkFormat GetDepthFormat() const
+			{
+				return depthFormat;
+			}
+
+			RenderGraph& GetRenderGraph()
+			{
+				return *renderGraph;
+			}
+
+			void SetRenderGraphCallback(const Function<void(RenderGraph&, RenderGraphResource)>& callback)
+			{
+				renderGraphCallback = callback;
 			}
 
 			VkExtent2D GetSwapChainExtent() const
@@ -203,17 +392,33 @@ namespace RenderVulkan
 
 			VkSemaphore GetImageAvailableSemaphore(Size index) const
 			{
-				return imageAvailableSemaphores[index];
+				return frameContexts[index].imageAvailableSemaphore;
 			}
 
 			VkSemaphore GetRenderFinishedSemaphore(Size index) const
 			{
-				return renderFinishedSemaphores[index];
+				return frameContexts[index].renderFinishedSemaphore;
+			}
+
+			ullong GetFrameTimelineValue(Size index) const
+			{
+				return frameContexts[index].timelineValue;
+			}
+
+			void SetFramesInFlight(Size count)
+			{
+				if (isInitalized)
+				{
+					Logger_WriteConsole("Frames in flight must be set before the renderer is initialized", LogLevel::WARNING);
+					return;
+				}
+
+				Settings::GetInstance()->Set<uint>("framesInFlight", static_cast<uint>(std::max<Size>(count, 1)));
 			}
 
-			VkFence GetInFlightFence(Size index) const
+			Size GetFramesInFlight() const
 			{
-				return inFlightFences[index];
+				return framesInFlight;
 			}
 
 			void SetCurrentFrame(Size index)
@@ -228,30 +433,52 @@ namespace RenderVulkan
 
 			void CleanUp()
 			{
+				UploadManager::GetInstance()->Flush();
+
 				vkDeviceWaitIdle(device);
+
+				if (recordingThreadPool)
+					recordingThreadPool->Stop();
+
+				TimelineScheduler::GetInstance()->CleanUp();
+				UploadManager::GetInstance()->CleanUp();
+				GpuProfiler::GetInstance()->CleanUp();
+				PipelineStateCache::GetInstance()->CleanUp();
+				BindlessManager::GetInstance()->CleanUp();
+				UniformRingBuffer::GetInstance()->CleanUp();
+				DescriptorSetCache::GetInstance()->CleanUp();
+				LayoutCache::GetInstance()->CleanUp();
+
+				if (DynamicStateTracker::GetInstance()->IsEnabled())
+					Logger_WriteConsole(Formatter::Format("Dynamic pipeline state: '{}' commands emitted, '{}' redundant commands skipped", DynamicStateTracker::GetInstance()->GetEmittedCount(), DynamicStateTracker::GetInstance()->GetSkippedCount()), LogLevel::INFORMATION);
+
+				PipelineCache::GetInstance()->CleanUp();
 				
-				for (Size i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) 
+				for (FrameContext& frame : frameContexts) 
 				{
-					vkDestroySemaphore(device, renderFinishedSemaphores[i], nullptr);
-					vkDestroySemaphore(device, imageAvailableSemaphores[i], nullptr);
-					vkDestroyFence(device, inFlightFences[i], nullptr);
+					for (VkCommandPool workerCommandPool : frame.workerCommandPools)
+						vkDestroyCommandPool(device, workerCommandPool, nullptr);
+
+					vkDestroySemaphore(device, frame.renderFinishedSemaphore, nullptr);
+					vkDestroySemaphore(device, frame.imageAvailableSemaphore, nullptr);
+					vkDestroyCommandPool(device, frame.commandPool, nullptr);
 				}
 
-				for (auto framebuffer : swapChainFramebuffers) 
-					vkDestroyFramebuffer(device, framebuffer, nullptr);
+				frameContexts.clear();
 
-				vkDestroyRenderPass(device, renderPass, nullptr);
+				renderGraph->CleanUp();
+				renderGraph.reset();
 
 				for (auto imageView : swapChainImageViews) 
 					vkDestroyImageView(device, imageView, nullptr);
 				
-				vkDestroySwapchainKHR(device, swapChain, nullptr);
-
-				vkFreeCommandBuffers(device, commandPool, static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
-
-				vkDestroyCommandPool(device, commandPool, nullptr);
+				if (isHeadless)
+					DestroyOffscreenImages();
+				else
+					vkDestroySwapchainKHR(device, swapChain, nullptr);
 
-				vkDestroySurfaceKHR(instance, surface, nullptr);
+				if (surface != VK_NULL_HANDLE)
+					vkDestroySurfaceKHR(instance, surface, nullptr);
 
 				vkDestroyDevice(device, nullptr);
 
@@ -279,11 +506,22 @@ namespace RenderVulkan
 
 		private:
 
+			struct RetiredSwapChain
+			{
+				VkSwapchainKHR swapChain = VK_NULL_HANDLE;
+				Vector<VkImage> offscreenImages;
+				Vector<VkDeviceMemory> offscreenImageMemories;
+				Vector<VkImageView> imageViews;
+				Shared<RenderGraph> renderGraph;
+			};
+
 			Renderer() = default; 
 
 			void CreateInstance()
 			{
-				Vector<const char*> requiredExtensions = VulkanHelper::GetRequiredExtensions(enableValidationLayers, validationLayers);
+				Vector<const char*> requiredExtensions = VulkanHelper::GetRequiredExtensions(enableValidationLayers, validationLayers, isHeadless);
+
+				instanceApiVersion = DeviceCapabilities::GetInstanceApiVersion();
 
 				VkApplicationInfo applicationInformation{};
 
@@ -292,7 +530,7 @@ namespace RenderVulkan
 				applicationInformation.applicationVersion = VK_MAKE_VERSION(0, 0, 1);
 				applicationInformation.pEngineName = "RenderVulkan";
 				applicationInformation.engineVersion = VK_MAKE_VERSION(0, 0, 1);
-				applicationInformation.apiVersion = VK_API_VERSION_1_0;
+				applicationInformation.apiVersion = instanceApiVersion;
 
 				VkInstanceCreateInfo creationInformation{};
 
@@ -349,37 +587,29 @@ namespace RenderVulkan
 
 			void CreatePhysicalDevice()
 			{
-				uint deviceCount = 0;
-				vkEnumeratePhysicalDevices(instance, &deviceCount, nullptr);
+				PhysicalDeviceDatabase::GetInstance()->Populate(instance, surface, instanceApiVersion, deviceExtensions);
 
-				if (deviceCount <= 0)
-					Logger_ThrowException("Failed to find GPU(s) with Vulkan support", true);
+				const PhysicalDeviceInformation& selectedDevice = PhysicalDeviceDatabase::GetInstance()->Select();
 
-				Vector<VkPhysicalDevice> devices(deviceCount);
-				vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
-
-				for (const auto& device : devices) 
-				{
-					if (VulkanHelper::IsDeviceCompatable(device, deviceExtensions, surface)) 
-					{
-						physicalDevice = device;
-						break;
-					}
-				}
-
-				if (physicalDevice == VK_NULL_HANDLE) 
-					Logger_ThrowException("failed to find a suitable GPU!", true);
+				physicalDevice = selectedDevice.handle;
+				deviceQueueFamilies = selectedDevice.queueFamilyIndices;
+				transferQueueFamily = selectedDevice.dedicatedTransferFamily;
+				deviceCapabilities = selectedDevice.capabilities;
+				deviceCapabilities.Log();
 				
 				Logger_WriteConsole("Physical device selected", LogLevel::INFORMATION);
 			}
 
 			void CreateLogicalDevice()
 			{
-				QueueFamilyIndices indices = VulkanHelper::FindQueueFamilies(physicalDevice, surface);
+				QueueFamilyIndices indices = deviceQueueFamilies;
 
 				Vector<VkDeviceQueueCreateInfo> queueCreationInformations{};
 				Set<uint> uniqueQueueFamilies = { indices.graphicsFamily.value(), indices.presentFamily.value() };
 
+				if (transferQueueFamily.has_value())
+					uniqueQueueFamilies.insert(transferQueueFamily.value());
+
 				float queuePriority = 1.0f;
 
 				for (uint queueFamily : uniqueQueueFamilies) 
@@ -394,9 +624,8 @@ namespace RenderVulkan
 					queueCreationInformations.push_back(queueCreationInformation);
 				}
 
-				VkPhysicalDeviceFeatures deviceFeatures{};
-				deviceFeatures.samplerAnisotropy = VK_TRUE;
-				deviceFeatures.sampleRateShading = VK_TRUE;
+				for (const char* extension : deviceCapabilities.GetRequiredExtensions())
+					deviceExtensions.push_back(extension);
 
 				VkDeviceCreateInfo creationInformation{};
 
@@ -404,7 +633,8 @@ namespace RenderVulkan
 				creationInformation.queueCreateInfoCount = static_cast<uint>(queueCreationInformations.size());
 				creationInformation.pQueueCreateInfos = queueCreationInformations.data();
 				
-				creationInformation.pEnabledFeatures = &deviceFeatures;
+				creationInformation.pEnabledFeatures = nullptr;
+				creationInformation.pNext = deviceCapabilities.BuildFeatureChain();
 
 				creationInformation.enabledExtensionCount = static_cast<uint>(deviceExtensions.size());
 				creationInformation.ppEnabledExtensionNames = deviceExtensions.data();
@@ -424,23 +654,10 @@ namespace RenderVulkan
 				vkGetDeviceQueue(device, indices.graphicsFamily.value(), 0, &graphicsQueue);
 				vkGetDeviceQueue(device, indices.presentFamily.value(), 0, &presentQueue);
 
-				Logger_WriteConsole("Logical device created", LogLevel::INFORMATION);
-			}
+				if (transferQueueFamily.has_value())
+					vkGetDeviceQueue(device, transferQueueFamily.value(), 0, &transferQueue);
 
-			void CreateCommandPool() 
-			{
-				QueueFamilyIndices queueFamilyIndices = VulkanHelper::FindQueueFamilies(physicalDevice, surface);
-
-				VkCommandPoolCreateInfo poolInformation = {};
-
-				poolInformation.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-				poolInformation.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
-				poolInformation.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-
-				VkResult result = vkCreateCommandPool(device, &poolInformation, nullptr, &commandPool);
-				Logger_ThrowIfFailed(result, "Failed to create command pool", true);
-
-				Logger_WriteConsole("Command pool created", LogLevel::INFORMATION);
+				Logger_WriteConsole("Logical device created", LogLevel::INFORMATION);
 			}
 
 			void CreateWindowSurface()
@@ -457,7 +674,7 @@ namespace RenderVulkan
 				Logger_WriteConsole("Window surface created", LogLevel::INFORMATION);
 			}
 
-			void CreateSwapChain()
+			void CreateSwapChain(VkSwapchainKHR oldSwapChain = VK_NULL_HANDLE)
 			{
 				SwapChainSupportDetails swapChainSupport = VulkanHelper::GetSwapChainSupport(physicalDevice, surface);
 
@@ -481,7 +698,7 @@ namespace RenderVulkan
 				creationInformation.imageArrayLayers = 1;
 				creationInformation.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
 
-				QueueFamilyIndices indices = VulkanHelper::FindQueueFamilies(physicalDevice, surface);
+				QueueFamilyIndices indices = deviceQueueFamilies;
 				uint queueFamilyIndices[] = { indices.graphicsFamily.value(), indices.presentFamily.value() };
 
 				if (indices.graphicsFamily != indices.presentFamily) 
@@ -501,6 +718,7 @@ namespace RenderVulkan
 				creationInformation.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
 				creationInformation.presentMode = presentMode;
 				creationInformation.clipped = VK_TRUE;
+				creationInformation.oldSwapchain = oldSwapChain;
 
 				VkResult result = vkCreateSwapchainKHR(device, &creationInformation, nullptr, &swapChain);
 
@@ -521,6 +739,65 @@ namespace RenderVulkan
 				Logger_WriteConsole("Swap chain created", LogLevel::INFORMATION);
 			}
 
+			void CreateOffscreenImages(const Vector2i& dimensions)
+			{
+				swapChainImageFormat = VulkanHelper::FindColorFormat(physicalDevice);
+				swapChainExtent = { static_cast<uint>(std::max(dimensions.x, 1)), static_cast<uint>(std::max(dimensions.y, 1)) };
+
+				swapChainImages.resize(framesInFlight);
+				offscreenImageMemories.resize(framesInFlight);
+
+				for (Size i = 0; i < swapChainImages.size(); i++)
+				{
+					VkImageCreateInfo creationInformation{};
+
+					creationInformation.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+					creationInformation.imageType = VK_IMAGE_TYPE_2D;
+					creationInformation.format = swapChainImageFormat;
+					creationInformation.extent = { swapChainExtent.width, swapChainExtent.height, 1 };
+					creationInformation.mipLevels = 1;
+					creationInformation.arrayLayers = 1;
+					creationInformation.samples = VK_SAMPLE_COUNT_1_BIT;
+					creationInformation.tiling = VK_IMAGE_TILING_OPTIMAL;
+					creationInformation.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+					creationInformation.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+					creationInformation.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+					VkResult result = vkCreateImage(device, &creationInformation, nullptr, &swapChainImages[i]);
+					Logger_ThrowIfFailed(result, "Failed to create offscreen image", true);
+
+					VkMemoryRequirements memoryRequirements;
+					vkGetImageMemoryRequirements(device, swapChainImages[i], &memoryRequirements);
+
+					VkMemoryAllocateInfo allocationInformation{};
+
+					allocationInformation.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+					allocationInformation.allocationSize = memoryRequirements.size;
+					allocationInformation.memoryTypeIndex = VulkanHelper::FindMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+					result = vkAllocateMemory(device, &allocationInformation, nullptr, &offscreenImageMemories[i]);
+					Logger_ThrowIfFailed(result, "Failed to allocate offscreen image memory", true);
+
+					vkBindImageMemory(device, swapChainImages[i], offscreenImageMemories[i], 0);
+				}
+
+				Settings::GetInstance()->Set<VkExtent2D>("swapChainExtent", swapChainExtent);
+
+				Logger_WriteConsole("Offscreen images created", LogLevel::INFORMATION);
+			}
+
+			void DestroyOffscreenImages()
+			{
+				for (auto image : swapChainImages)
+					vkDestroyImage(device, image, nullptr);
+
+				for (auto memory : offscreenImageMemories)
+					vkFreeMemory(device, memory, nullptr);
+
+				swapChainImages.clear();
+				offscreenImageMemories.clear();
+			}
+
 			void CreateImageViews()
 			{
 				swapChainImageViews.resize(swapChainImages.size());
@@ -553,171 +830,408 @@ namespace RenderVulkan
 				Logger_WriteConsole("Image views created", LogLevel::INFORMATION);
 			}
 
-			void CreateRenderPass() 
+			void BuildRenderGraph()
+			{
+				renderGraph = RenderGraph::Create();
+
+				RenderGraphResource backbuffer = renderGraph->ImportImage("Backbuffer", swapChainImageFormat, swapChainImages, swapChainImageViews, isHeadless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+				RenderGraphResource depth = renderGraph->CreateImage("Depth", { depthFormat, sampleCount });
+				RenderGraphResource color = backbuffer;
+
+				if (sampleCount != VK_SAMPLE_COUNT_1_BIT)
+					color = renderGraph->CreateImage("Color (MSAA)", { swapChainImageFormat, sampleCount });
+
+				if (isDepthPrepassEnabled)
+				{
+					depthPrepass = renderGraph->AddPass("Depth prepass", [depth](RenderGraphBuilder& builder)
+					{
+						builder.WriteDepth(depth, VkClearDepthStencilValue{ 1.0f, 0 });
+					},
+					[this](VkCommandBuffer commandBuffer, const RenderGraphPassContext& context)
+					{
+						if (!depthRenderCallback)
+							return;
+
+						GpuZone zone(commandBuffer, "Game objects (depth)");
+
+						depthRenderCallback(commandBuffer, context.imageIndex);
+					});
+				}
+
+				scenePass = renderGraph->AddPass("Scene", [this, backbuffer, depth, color](RenderGraphBuilder& builder)
+				{
+					builder.WriteColor(color, VkClearColorValue{ { 0.0f, 0.45f, 0.75f, 1.0f } });
+
+					if (color != backbuffer)
+						builder.ResolveColor(color, backbuffer);
+
+					if (isDepthPrepassEnabled)
+						builder.ReadDepth(depth);
+					else
+						builder.WriteDepth(depth, VkClearDepthStencilValue{ 1.0f, 0 });
+
+					builder.UseSecondaryCommandBuffers(IsRecordingInParallel());
+				},
+				[this](VkCommandBuffer commandBuffer, const RenderGraphPassContext& context)
+				{
+					if (IsRecordingInParallel())
+					{
+						RecordSecondaryCommandBuffers(frameContexts[currentFrame], context);
+
+						const Vector<VkCommandBuffer>& secondaryCommandBuffers = frameContexts[currentFrame].secondaryCommandBuffers[context.imageIndex];
+						vkCmdExecuteCommands(commandBuffer, static_cast<uint>(secondaryCommandBuffers.size()), secondaryCommandBuffers.data());
+					}
+					else
+					{
+						GpuZone zone(commandBuffer, "Game objects");
+
+						renderCallback(commandBuffer, context.imageIndex);
+					}
+				});
+
+				if (renderGraphCallback)
+					renderGraphCallback(*renderGraph, backbuffer);
+
+				renderGraph->Compile(swapChainExtent);
+			}
+
+			VkSampleCountFlagBits ChooseSampleCount(uint samples) const
+			{
+				VkSampleCountFlagBits maximumSampleCount = VulkanHelper::GetMaxUsableSampleCount(physicalDevice);
+				VkSampleCountFlagBits chosenSampleCount = VK_SAMPLE_COUNT_1_BIT;
+
+				while (chosenSampleCount < maximumSampleCount && static_cast<uint>(chosenSampleCount) * 2 <= samples)
+					chosenSampleCount = static_cast<VkSampleCountFlagBits>(chosenSampleCount * 2);
+
+				if (samples > static_cast<uint>(chosenSampleCount))
+					Logger_WriteConsole(Formatter::Format("'{}' samples requested, using '{}'", samples, static_cast<uint>(chosenSampleCount)), LogLevel::WARNING);
+
+				return chosenSampleCount;
+			}
+
+			void RecordCommandBuffer(VkCommandBuffer commandBuffer, uint imageIndex) 
 			{
-				VkAttachmentDescription colorAttachment = {};
+				Profiler_Function();
 
-				colorAttachment.format = swapChainImageFormat;
-				colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-				colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-				colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-				colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-				colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-				colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-				colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+				VkCommandBufferBeginInfo beginInfo = {};
 
-				VkAttachmentReference colorAttachmentRef = {};
+				beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
-				colorAttachmentRef.attachment = 0;
-				colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+				VkResult result = vkBeginCommandBuffer(commandBuffer, &beginInfo);
+				Logger_ThrowIfFailed(result, "Failed to begin recording command buffer", true);
 
-				VkSubpassDescription subpass = {};
+				DynamicStateTracker::GetInstance()->Begin(commandBuffer);
+				BindlessManager::GetInstance()->Begin(commandBuffer);
 
-				subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-				subpass.colorAttachmentCount = 1;
-				subpass.pColorAttachments = &colorAttachmentRef;
+				GpuProfiler::GetInstance()->BeginRecording(currentFrame, imageIndex, commandBuffer);
 
-				VkSubpassDependency dependency = {};
+				renderGraph->SetSecondaryCommandBuffers(scenePass, IsRecordingInParallel());
+				renderGraph->Execute(commandBuffer, imageIndex);
 
-				dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-				dependency.dstSubpass = 0;
-				dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-				dependency.srcAccessMask = 0;
-				dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-				dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+				result = vkEndCommandBuffer(commandBuffer);
+				Logger_ThrowIfFailed(result, "Failed to record command buffer", true);
+			}
+
+			void RenderOffscreen()
+			{
+				FrameContext& frame = frameContexts[currentFrame];
 
-				VkRenderPassCreateInfo renderPassInformation = {};
+				WaitForFrame(frame);
 
-				renderPassInformation.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-				renderPassInformation.attachmentCount = 1;
-				renderPassInformation.pAttachments = &colorAttachment;
-				renderPassInformation.subpassCount = 1;
-				renderPassInformation.pSubpasses = &subpass;
-				renderPassInformation.dependencyCount = 1;
-				renderPassInformation.pDependencies = &dependency;
+				uint imageIndex = static_cast<uint>(currentFrame);
 
-				VkResult result = vkCreateRenderPass(device, &renderPassInformation, nullptr, &renderPass);
-				Logger_ThrowIfFailed(result, "Failed to create render pass", true);
+				PrepareFrameCommandBuffer(frame, imageIndex);
 
-				Logger_WriteConsole("Render pass created", LogLevel::INFORMATION);
+				frame.timelineValue = TimelineScheduler::GetInstance()->Submit(graphicsQueue, { frame.commandBuffer });
+
+				currentFrame = (currentFrame + 1) % framesInFlight;
+
+				UpdateFrameStatistics();
 			}
 
-			void CreateFramebuffers() 
+			void UpdateFrameStatistics()
 			{
-				swapChainFramebuffers.resize(swapChainImageViews.size());
+				totalFrameCount++;
+				framesSinceLastStatistics++;
+
+				TimePoint now = Clock::now();
+				float elapsed = Duration(now - lastStatisticsTime).count();
+
+				if (elapsed < 1.0f)
+					return;
 
-				for (size_t i = 0; i < swapChainImageViews.size(); i++) 
+				framesPerSecond = static_cast<float>(framesSinceLastStatistics) / elapsed;
+				framesSinceLastStatistics = 0;
+				lastStatisticsTime = now;
+
+				if (!isHeadless)
+					return;
+
+				Logger_WriteConsole(Formatter::Format("Frames per second: '{:.1f}'", framesPerSecond), LogLevel::INFORMATION);
+
+				for (const GpuZoneResult& zone : GpuProfiler::GetInstance()->GetResults())
+					Logger_WriteConsole(Formatter::Format("    GPU '{}': {:.3f} ms (average {:.3f} ms)", zone.name, zone.milliseconds, GpuProfiler::GetInstance()->GetAverage(zone.name)), LogLevel::INFORMATION);
+			}
+
+			void RecordSecondaryCommandBuffers(FrameContext& frame, const RenderGraphPassContext& context)
+			{
+				Size workerCount = frame.workerCommandPools.size();
+				uint imageIndex = context.imageIndex;
+				VkRenderPass renderPass = context.renderPass;
+				VkFramebuffer framebuffer = context.framebuffer;
+
+				recordingThreadPool->Dispatch(workerCount, [this, &frame, imageIndex, renderPass, framebuffer, workerCount](Size worker)
 				{
-					VkImageView attachments[] = { swapChainImageViews[i] };
+					Profiler_Scope("Record secondary command buffer");
+
+					VkCommandBuffer secondaryCommandBuffer = frame.secondaryCommandBuffers[imageIndex][worker];
+
+					VkCommandBufferInheritanceInfo inheritanceInformation = {};
+
+					inheritanceInformation.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+					inheritanceInformation.renderPass = renderPass;
+					inheritanceInformation.subpass = 0;
+					inheritanceInformation.framebuffer = framebuffer;
+
+					VkCommandBufferBeginInfo beginInfo = {};
+
+					beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+					beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+					beginInfo.pInheritanceInfo = &inheritanceInformation;
+
+					VkResult result = vkBeginCommandBuffer(secondaryCommandBuffer, &beginInfo);
+					Logger_ThrowIfFailed(result, "Failed to begin recording secondary command buffer", true);
+
+					DynamicStateTracker::GetInstance()->Begin(secondaryCommandBuffer);
+					BindlessManager::GetInstance()->Begin(secondaryCommandBuffer);
 
-					VkFramebufferCreateInfo framebufferInformation = {};
+					{
+						GpuZone zone(secondaryCommandBuffer, Formatter::Format("Game objects [{}]", worker));
+
+						parallelRenderCallback(secondaryCommandBuffer, worker, workerCount);
+					}
+
+					result = vkEndCommandBuffer(secondaryCommandBuffer);
+					Logger_ThrowIfFailed(result, "Failed to record secondary command buffer", true);
+				});
+			}
 
-					framebufferInformation.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-					framebufferInformation.renderPass = renderPass;
-					framebufferInformation.attachmentCount = 1;
-					framebufferInformation.pAttachments = attachments;
-					framebufferInformation.width = swapChainExtent.width;
-					framebufferInformation.height = swapChainExtent.height;
-					framebufferInformation.layers = 1;
+			void CreateFrameContexts() 
+			{
+				QueueFamilyIndices queueFamilyIndices = deviceQueueFamilies;
+
+				frameContexts.resize(framesInFlight);
 
-					VkResult result = vkCreateFramebuffer(device, &framebufferInformation, nullptr, &swapChainFramebuffers[i]);
+				VkCommandPoolCreateInfo poolInformation = {};
 
-					Logger_ThrowIfFailed(result, "Failed to create framebuffer", true);
+				poolInformation.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+				poolInformation.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
+				poolInformation.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+				VkSemaphoreCreateInfo semaphoreInformation = {};
+
+				semaphoreInformation.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+				for (FrameContext& frame : frameContexts) 
+				{
+					VkResult result = vkCreateCommandPool(device, &poolInformation, nullptr, &frame.commandPool);
+					Logger_ThrowIfFailed(result, "Failed to create frame command pool", true);
+
+					if (recordingThreadPool)
+					{
+						frame.workerCommandPools.resize(recordingThreadPool->GetThreadCount());
+
+						for (VkCommandPool& workerCommandPool : frame.workerCommandPools)
+						{
+							result = vkCreateCommandPool(device, &poolInformation, nullptr, &workerCommandPool);
+							Logger_ThrowIfFailed(result, "Failed to create worker command pool", true);
+						}
+					}
+
+					EnsureImageCommandBuffers(frame, swapChainImages.size());
+
+					result = vkCreateSemaphore(device, &semaphoreInformation, nullptr, &frame.imageAvailableSemaphore);
+					Logger_ThrowIfFailed(result, "Failed to create image available semaphore", true);
+
+					result = vkCreateSemaphore(device, &semaphoreInformation, nullptr, &frame.renderFinishedSemaphore);
+					Logger_ThrowIfFailed(result, "Failed to create render finished semaphore", true);
+
+					frame.scratchMemory.resize(frameScratchSize);
 				}
 
-				Logger_WriteConsole("Framebuffers created", LogLevel::INFORMATION);
+				Logger_WriteConsole(Formatter::Format("Frame contexts created; '{}' frames in flight", framesInFlight), LogLevel::INFORMATION);
 			}
 
-			void CreateCommandBuffers() 
+			void EnsureImageCommandBuffers(FrameContext& frame, Size imageCount)
 			{
-				commandBuffers.resize(swapChainFramebuffers.size());
+				Size existingCount = frame.imageCommandBuffers.size();
+
+				if (existingCount >= imageCount)
+					return;
+
+				frame.imageCommandBuffers.resize(imageCount);
+				frame.imageRevisions.resize(imageCount, ChangeTracker::NO_REVISION);
+				frame.secondaryCommandBuffers.resize(imageCount);
 
 				VkCommandBufferAllocateInfo allocationInformation = {};
 
 				allocationInformation.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-				allocationInformation.commandPool = commandPool;
+				allocationInformation.commandPool = frame.commandPool;
 				allocationInformation.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-				allocationInformation.commandBufferCount = (uint32_t)commandBuffers.size();
+				allocationInformation.commandBufferCount = static_cast<uint>(imageCount - existingCount);
 
-				VkResult result = vkAllocateCommandBuffers(device, &allocationInformation, commandBuffers.data());
-				Logger_ThrowIfFailed(result, "Failed to allocate command buffers", true);
+				VkResult result = vkAllocateCommandBuffers(device, &allocationInformation, &frame.imageCommandBuffers[existingCount]);
+				Logger_ThrowIfFailed(result, "Failed to allocate frame command buffers", true);
 
-				Logger_WriteConsole("Command buffers allocated", LogLevel::INFORMATION);
+				allocationInformation.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+				allocationInformation.commandBufferCount = 1;
+
+				for (Size i = existingCount; i < imageCount; i++)
+				{
+					frame.secondaryCommandBuffers[i].resize(frame.workerCommandPools.size());
+
+					for (Size w = 0; w < frame.workerCommandPools.size(); w++)
+					{
+						allocationInformation.commandPool = frame.workerCommandPools[w];
+
+						result = vkAllocateCommandBuffers(device, &allocationInformation, &frame.secondaryCommandBuffers[i][w]);
+						Logger_ThrowIfFailed(result, "Failed to allocate secondary command buffer", true);
+					}
+				}
 			}
 
-			void RecordCommandBuffer(VkCommandBuffer commandBuffer, uint imageIndex) 
+			void PrepareFrameCommandBuffer(FrameContext& frame, uint imageIndex)
 			{
-				VkCommandBufferBeginInfo beginInfo = {};
+				ullong revision = ChangeTracker::GetInstance()->GetRevision();
 
-				beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+				EnsureImageCommandBuffers(frame, std::max<Size>(swapChainImages.size(), imageIndex + 1));
 
-				VkResult result = vkBeginCommandBuffer(commandBuffer, &beginInfo);
-				Logger_ThrowIfFailed(result, "Failed to begin recording command buffer", true);
+				UniformRingBuffer::GetInstance()->BeginFrame(currentFrame);
+				BindlessManager::GetInstance()->BeginFrame(currentFrame);
 
-				VkRenderPassBeginInfo renderPassInfo = {};
+				if (!isCommandBufferCachingEnabled || frame.recordedRevision != revision)
+				{
+					BeginFrame(frame);
+					frame.recordedRevision = revision;
+				}
+				else
+					frame.ResetScratch();
 
-				renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-				renderPassInfo.renderPass = renderPass;
-				renderPassInfo.framebuffer = swapChainFramebuffers[imageIndex];
-				renderPassInfo.renderArea.offset = { 0, 0 };
-				renderPassInfo.renderArea.extent = swapChainExtent;
+				frame.commandBuffer = frame.imageCommandBuffers[imageIndex];
 
-				VkClearValue clearColor = { 0.0f, 0.45f, 0.75f, 1.0f };
+				GpuProfiler::GetInstance()->MarkSubmitted(currentFrame, imageIndex);
 
-				renderPassInfo.clearValueCount = 1;
-				renderPassInfo.pClearValues = &clearColor;
+				if (frame.imageRevisions[imageIndex] == revision)
+					return;
 
-				vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+				RecordCommandBuffer(frame.commandBuffer, imageIndex);
 
-				renderCallback(commandBuffer, imageIndex);
+				frame.imageRevisions[imageIndex] = revision;
+			}
 
-				vkCmdEndRenderPass(commandBuffer);
+			void BeginFrame(FrameContext& frame)
+			{
+				VkResult result = vkResetCommandPool(device, frame.commandPool, 0);
+				Logger_ThrowIfFailed(result, "Failed to reset frame command pool", true);
 
-				result = vkEndCommandBuffer(commandBuffer);
-				Logger_ThrowIfFailed(result, "Failed to record command buffer", true);
+				for (VkCommandPool workerCommandPool : frame.workerCommandPools)
+				{
+					result = vkResetCommandPool(device, workerCommandPool, 0);
+					Logger_ThrowIfFailed(result, "Failed to reset worker command pool", true);
+				}
+
+				UniformRingBuffer::GetInstance()->Reset();
+
+				std::fill(frame.imageRevisions.begin(), frame.imageRevisions.end(), ChangeTracker::NO_REVISION);
+
+				frame.ResetScratch();
 			}
 
-			void CreateSyncObjects() 
+			void WaitForFrame(FrameContext& frame)
 			{
-				imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-				renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-				inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
-
-				VkSemaphoreCreateInfo semaphoreInformation = {};
+				Profiler_Function();
 
-				semaphoreInformation.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+				TimelineScheduler::GetInstance()->Wait(frame.timelineValue);
+				TimelineScheduler::GetInstance()->Poll();
 
-				VkFenceCreateInfo fenceInformation = {};
+				GpuProfiler::GetInstance()->Resolve(currentFrame);
+			}
 
-				fenceInformation.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-				fenceInformation.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+			bool RecreateSwapChain()
+			{
+				VkExtent2D extent = {};
 
-				for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) 
+				if (isHeadless)
+					extent = { static_cast<uint>(std::max(pendingDimensions.x, 0)), static_cast<uint>(std::max(pendingDimensions.y, 0)) };
+				else
 				{
-					VkResult result = vkCreateSemaphore(device, &semaphoreInformation, nullptr, &imageAvailableSemaphores[i]);
-					Logger_ThrowIfFailed(result, "Failed to create image available semaphore", true);
+					SwapChainSupportDetails swapChainSupport = VulkanHelper::GetSwapChainSupport(physicalDevice, surface);
+					extent = VulkanHelper::GetSwapExtent(swapChainSupport.capabilities);
+				}
 
-					result = vkCreateSemaphore(device, &semaphoreInformation, nullptr, &renderFinishedSemaphores[i]);
-					Logger_ThrowIfFailed(result, "Failed to create render finished semaphore", true);
+				if (extent.width == 0 || extent.height == 0)
+					return false;
+
+				isSwapChainRecreationPending = false;
+
+				VkSwapchainKHR oldSwapChain = RetireSwapChain();
+
+				if (isHeadless)
+					CreateOffscreenImages(pendingDimensions);
+				else
+					CreateSwapChain(oldSwapChain);
+
+				CreateImageViews();
+				BuildRenderGraph();
+
+				ChangeTracker::GetInstance()->Invalidate();
+
+				return true;
+			}
+
+			VkSwapchainKHR RetireSwapChain()
+			{
+				RetiredSwapChain retired = {};
 
-					result = vkCreateFence(device, &fenceInformation, nullptr, &inFlightFences[i]);
-					Logger_ThrowIfFailed(result, "Failed to create in flight fence", true);
+				retired.swapChain = swapChain;
+				retired.imageViews = std::move(swapChainImageViews);
+				retired.renderGraph = std::move(renderGraph);
+
+				if (isHeadless)
+				{
+					retired.offscreenImages = std::move(swapChainImages);
+					retired.offscreenImageMemories = std::move(offscreenImageMemories);
 				}
 
-				Logger_WriteConsole("Sync objects created", LogLevel::INFORMATION);
+				TimelineScheduler::GetInstance()->OnLastSubmittedComplete([this, retired]()
+				{
+					DestroyRetiredSwapChain(retired);
+				});
+
+				swapChain = VK_NULL_HANDLE;
+				swapChainImages.clear();
+				swapChainImageViews.clear();
+				offscreenImageMemories.clear();
+
+				return retired.swapChain;
 			}
 
-			void CleanUpSwapChain() 
+			void DestroyRetiredSwapChain(const RetiredSwapChain& retired)
 			{
-				for (auto framebuffer : swapChainFramebuffers) 
-					vkDestroyFramebuffer(device, framebuffer, nullptr);
-				
-				vkFreeCommandBuffers(device, commandPool, static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
+				if (retired.renderGraph)
+					retired.renderGraph->CleanUp();
 
-				for (auto imageView : swapChainImageViews) 
+				for (auto imageView : retired.imageViews)
 					vkDestroyImageView(device, imageView, nullptr);
-				
-				vkDestroySwapchainKHR(device, swapChain, nullptr);
+
+				for (auto image : retired.offscreenImages)
+					vkDestroyImage(device, image, nullptr);
+
+				for (auto memory : retired.offscreenImageMemories)
+					vkFreeMemory(device, memory, nullptr);
+
+				if (retired.swapChain != VK_NULL_HANDLE)
+					vkDestroySwapchainKHR(device, retired.swapChain, nullptr);
 			}
 
 			static VKAPI_ATTR VkBool32 VKAPI_CALL DebugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity, VkDebugUtilsMessageTypeFlagsEXT messageType, const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData, void* pUserData) 
@@ -735,32 +1249,45 @@ namespace RenderVulkan
 			VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
 			VkQueue graphicsQueue = VK_NULL_HANDLE;
 			VkQueue presentQueue = VK_NULL_HANDLE;
+			VkQueue transferQueue = VK_NULL_HANDLE;
 
 			VkSwapchainKHR swapChain = VK_NULL_HANDLE;
 			Vector<VkImage> swapChainImages = {};
+			Vector<VkDeviceMemory> offscreenImageMemories = {};
 			VkFormat swapChainImageFormat = VkFormat::VK_FORMAT_UNDEFINED;
 			VkExtent2D swapChainExtent = {};
 
-			VkRenderPass renderPass = VK_NULL_HANDLE;
-			Vector<VkFramebuffer> swapChainFramebuffers = {};
-			Vector<VkCommandBuffer> commandBuffers = {};
-			
-			Vector<VkSemaphore> imageAvailableSemaphores;
-			Vector<VkSemaphore> renderFinishedSemaphores;
-			Vector<VkFence> inFlightFences;
+			Unique<RenderGraph> renderGraph;
+			RenderGraphPass scenePass = 0;
+			RenderGraphPass depthPrepass = 0;
+			VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+			VkSampleCountFlagBits sampleCount = VK_SAMPLE_COUNT_1_BIT;
+			bool isDepthPrepassEnabled = false;
+			Function<void(RenderGraph&, RenderGraphResource)> renderGraphCallback;
+
+			Vector<FrameContext> frameContexts = {};
 
-			VkCommandPool commandPool = VK_NULL_HANDLE;
 
 			Size currentFrame = 0;
-			const Size MAX_FRAMES_IN_FLIGHT = 2;
+			Size framesInFlight = 2;
+			Size frameScratchSize = 256 * 1024;
 
 			Vector<VkImageView> swapChainImageViews = {};
 
+			bool isSwapChainRecreationPending = false;
+			Vector2i pendingDimensions = {};
+
 			VkDebugUtilsMessengerEXT debugMessenger = VK_NULL_HANDLE;
 			
 			VkSurfaceKHR surface = VK_NULL_HANDLE;
 
 			Function<void(VkCommandBuffer, int)> renderCallback;
+			Function<void(VkCommandBuffer, int)> depthRenderCallback;
+			Function<void(VkCommandBuffer, Size, Size)> parallelRenderCallback;
+
+			Size recordingThreadCount = 0;
+			bool isCommandBufferCachingEnabled = false;
+			Unique<ThreadPool> recordingThreadPool;
 
 			Vector<const char*> validationLayers = 
 			{
@@ -772,7 +1299,18 @@ namespace RenderVulkan
 				VK_KHR_SWAPCHAIN_EXTENSION_NAME
 			};
 
+			uint instanceApiVersion = VK_API_VERSION_1_0;
+			DeviceCapabilities deviceCapabilities;
+			QueueFamilyIndices deviceQueueFamilies;
+			Optional<uint> transferQueueFamily;
+
 			bool isInitalized = false;
+			bool isHeadless = false;
+
+			ullong totalFrameCount = 0;
+			ullong framesSinceLastStatistics = 0;
+			float framesPerSecond = 0.0f;
+			TimePoint lastStatisticsTime = {};
 
 #ifdef _DEBUG
 			const bool enableValidationLayers = true;
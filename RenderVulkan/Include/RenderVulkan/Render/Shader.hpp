@@ -4,7 +4,16 @@
 #include <GLFW/glfw3.h>
 #include "RenderVulkan/Core/Settings.hpp"
 #include "RenderVulkan/ECS/GameObject.hpp"
+#include "RenderVulkan/Render/BindlessManager.hpp"
 #include "RenderVulkan/Render/DescriptorManager.hpp"
+#include "RenderVulkan/Render/DeviceCapabilities.hpp"
+#include "RenderVulkan/Render/DynamicStateTracker.hpp"
+#include "RenderVulkan/Render/LayoutCache.hpp"
+#include "RenderVulkan/Render/PipelineStateCache.hpp"
+#include "RenderVulkan/Render/ShaderReflection.hpp"
+#include "RenderVulkan/Render/ShaderVariantKey.hpp"
+#include "RenderVulkan/Render/TimelineScheduler.hpp"
+#include "RenderVulkan/Render/UniformRingBuffer.hpp"
 #include "RenderVulkan/Render/Vertex.hpp"
 #include "RenderVulkan/Util/FileHelper.hpp"
 #include "RenderVulkan/Util/Formatter.hpp"
@@ -24,213 +33,140 @@ namespace RenderVulkan
 
 		public:
 
+            static constexpr uint CONSTANT_BUFFER_BINDING = 0;
+
 			Shader(const Shader&) = delete;
 			Shader& operator=(const Shader&) = delete;
 
             void CreatePipeline(VkRenderPass renderPass)
             {
-                VkDevice device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
+                CreatePipelineLayout();
+
+                PipelineStateKey key = GetPipelineStateKey(false);
 
-                VkPipelineShaderStageCreateInfo vertexShaderStageInfo{};
+                dynamicState = DynamicStateTracker::GetInstance()->Normalize(key);
+                pipeline = PipelineStateCache::GetInstance()->GetOrCreate(key, renderPass);
 
-                vertexShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-                vertexShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
-                vertexShaderStageInfo.module = vertexShaderModule;
-                vertexShaderStageInfo.pName = "Main";
+                ChangeTracker::GetInstance()->Invalidate();
+            }
 
-                VkPipelineShaderStageCreateInfo fragmentShaderStageInfo{};
+            void CreateDepthPipeline(VkRenderPass renderPass)
+            {
+                CreatePipelineLayout();
 
-                fragmentShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-                fragmentShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-                fragmentShaderStageInfo.module = fragmentShaderModule;
-                fragmentShaderStageInfo.pName = "Main";
+                PipelineStateKey key = GetPipelineStateKey(true);
 
-                VkPipelineShaderStageCreateInfo shaderStages[] = { vertexShaderStageInfo, fragmentShaderStageInfo };
+                depthDynamicState = DynamicStateTracker::GetInstance()->Normalize(key);
+                depthPipeline = PipelineStateCache::GetInstance()->GetOrCreate(key, renderPass);
 
-                Vector<VkDynamicState> dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+                ChangeTracker::GetInstance()->Invalidate();
+            }
 
-                VkPipelineDynamicStateCreateInfo dynamicState{};
+            PipelineStateKey GetPipelineStateKey(bool isDepthOnly = false) const
+            {
+                bool hasDepthVertexShader = isDepthOnly && depthVertexShaderModule != VK_NULL_HANDLE;
+                bool isDepthPrepassEnabled = Settings::GetInstance()->Get<bool>("depthPrepass");
+                float minSampleShading = Settings::GetInstance()->Get<float>("minSampleShading");
 
-                dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-                dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
-                dynamicState.pDynamicStates = dynamicStates.data();
+                PipelineStateKey key;
+
+                key.vertexShader = hasDepthVertexShader ? depthVertexShaderModule : vertexShaderModule;
+                key.fragmentShader = isDepthOnly ? VK_NULL_HANDLE : fragmentShaderModule;
+                key.pipelineLayout = pipelineLayout;
+                key.specialization = variant;
 
-                VkVertexInputBindingDescription bindingDescription = Vertex::GetBindingDescription();
                 Array<VkVertexInputAttributeDescription, 4> attributeDescriptions = Vertex::GetAttributeDescriptions();
 
-                VkPipelineVertexInputStateCreateInfo vertexInputInformation{};
+                key.vertexBinding = Vertex::GetBindingDescription();
+                key.vertexAttributes = (hasDepthVertexShader ? depthVertexReflection : vertexReflection).SelectVertexAttributes({ attributeDescriptions.begin(), attributeDescriptions.end() });
+
+                key.depthWrite = isDepthOnly || !isDepthPrepassEnabled;
+                key.depthCompareOp = isDepthOnly || !isDepthPrepassEnabled ? VK_COMPARE_OP_LESS : VK_COMPARE_OP_LESS_OR_EQUAL;
+                key.colorAttachmentCount = isDepthOnly ? 0 : 1;
+
+                key.sampleCount = Settings::GetInstance()->Get<VkSampleCountFlagBits>("sampleCount");
 
-                vertexInputInformation.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-                vertexInputInformation.vertexBindingDescriptionCount = 1;
-                vertexInputInformation.pVertexBindingDescriptions = &bindingDescription;
-                vertexInputInformation.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-                vertexInputInformation.pVertexAttributeDescriptions = attributeDescriptions.data();
-
-                VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
-
-                inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-                inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-                inputAssembly.primitiveRestartEnable = VK_FALSE;
-
-                VkExtent2D swapChainExtent = Settings::GetInstance()->Get<VkExtent2D>("swapChainExtent");
-
-                VkViewport viewport{};
-
-                viewport.x = 0.0f;
-                viewport.y = 0.0f;
-                viewport.width = static_cast<float>(swapChainExtent.width);
-                viewport.height = static_cast<float>(swapChainExtent.height);
-                viewport.minDepth = 0.0f;
-                viewport.maxDepth = 1.0f;
-
-                VkRect2D scissor{};
-
-                scissor.offset = { 0, 0 };
-                scissor.extent = swapChainExtent;
-
-                VkPipelineViewportStateCreateInfo viewportState{};
-
-                viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-                viewportState.viewportCount = 1;
-                viewportState.pViewports = &viewport;
-                viewportState.scissorCount = 1;
-                viewportState.pScissors = &scissor;
-
-                VkPipelineRasterizationStateCreateInfo rasterizer{};
-
-                rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-                rasterizer.depthClampEnable = VK_FALSE;
-                rasterizer.rasterizerDiscardEnable = VK_FALSE;
-                rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
-                rasterizer.lineWidth = 1.0f;
-                rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
-                rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
-                rasterizer.depthBiasEnable = VK_FALSE;
-                rasterizer.depthBiasConstantFactor = 0.0f;
-                rasterizer.depthBiasClamp = 0.0f;
-                rasterizer.depthBiasSlopeFactor = 0.0f;
-
-                VkPipelineMultisampleStateCreateInfo multisampling{};
-
-                multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-                multisampling.sampleShadingEnable = VK_FALSE;
-                multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-                multisampling.minSampleShading = 1.0f;
-                multisampling.pSampleMask = nullptr;
-                multisampling.alphaToCoverageEnable = VK_FALSE;
-                multisampling.alphaToOneEnable = VK_FALSE;
-
-                VkPipelineColorBlendAttachmentState colorBlendAttachment{};
-
-                colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-                colorBlendAttachment.blendEnable = VK_FALSE;
-                colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
-                colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
-                colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
-                colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-                colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
-                colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
-
-                VkPipelineColorBlendStateCreateInfo colorBlending{};
-
-                colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-                colorBlending.logicOpEnable = VK_FALSE;
-                colorBlending.logicOp = VK_LOGIC_OP_COPY;
-                colorBlending.attachmentCount = 1;
-                colorBlending.pAttachments = &colorBlendAttachment;
-                colorBlending.blendConstants[0] = 0.0f;
-                colorBlending.blendConstants[1] = 0.0f;
-                colorBlending.blendConstants[2] = 0.0f;
-                colorBlending.blendConstants[3] = 0.0f;
-
-                VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-
-                VkDescriptorSetLayout layout = descriptorManager->GetDescriptorSetLayout();
-
-                pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-                pipelineLayoutInfo.setLayoutCount = 1;
-                pipelineLayoutInfo.pSetLayouts = &layout;
-                pipelineLayoutInfo.pushConstantRangeCount = 0;
-                pipelineLayoutInfo.pPushConstantRanges = nullptr;
-
-                VkResult result = vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout);
-                Logger_ThrowIfFailed(result, "Failed to create pipeline layout", false);
-
-                VkGraphicsPipelineCreateInfo pipelineInfo{};
-
-                pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-                pipelineInfo.stageCount = 2;
-                pipelineInfo.pStages = shaderStages;
-                pipelineInfo.pVertexInputState = &vertexInputInformation;
-                pipelineInfo.pInputAssemblyState = &inputAssembly;
-                pipelineInfo.pViewportState = &viewportState;
-                pipelineInfo.pRasterizationState = &rasterizer;
-                pipelineInfo.pMultisampleState = &multisampling;
-                pipelineInfo.pDepthStencilState = nullptr;
-                pipelineInfo.pColorBlendState = &colorBlending;
-                pipelineInfo.pDynamicState = &dynamicState;
-                pipelineInfo.layout = pipelineLayout;
-                pipelineInfo.renderPass = renderPass;
-                pipelineInfo.subpass = 0;
-                pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
-                pipelineInfo.basePipelineIndex = -1;
-
-                result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline);
-                Logger_ThrowIfFailed(result, "Failed to create graphics pipeline", false);
+                if (!isDepthOnly && key.sampleCount != VK_SAMPLE_COUNT_1_BIT && minSampleShading > 0.0f && Settings::GetInstance()->Get<DeviceCapabilities>("deviceCapabilities").IsSupported(DeviceFeature::SAMPLE_RATE_SHADING))
+                    key.minSampleShading = minSampleShading;
+
+                return key;
             }
 
             void Bind(VkCommandBuffer commandBuffer)
 			{
-                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
-                const auto& descriptorSets = descriptorManager->GetDescriptorSets();
-                vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, PipelineStateCache::Resolve(pipeline));
+                DynamicStateTracker::GetInstance()->Apply(commandBuffer, dynamicState);
+                BindDescriptorSets(commandBuffer);
 			}
 
+            void BindDepth(VkCommandBuffer commandBuffer)
+            {
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, PipelineStateCache::Resolve(depthPipeline));
+                DynamicStateTracker::GetInstance()->Apply(commandBuffer, depthDynamicState);
+                BindDescriptorSets(commandBuffer);
+            }
+
             template<typename T>
             void CreateConstantBuffer()
             {
-                VkDevice device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
+                hasConstantBuffer = descriptorManager->HasBinding(CONSTANT_BUFFER_BINDING);
 
-                VkDeviceSize bufferSize = sizeof(T);
+                if (!hasConstantBuffer)
+                    return;
 
-                VkBufferCreateInfo bufferInformation{};
+                isConstantBufferDynamic = descriptorManager->GetDescriptorType(CONSTANT_BUFFER_BINDING) == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 
-                bufferInformation.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-                bufferInformation.size = bufferSize;
-                bufferInformation.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-                bufferInformation.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+                Vector<VkBuffer> buffers = { UniformRingBuffer::GetInstance()->GetBuffer() };
+                descriptorManager->CreateDescriptorSets(buffers, sizeof(T));
+            }
 
-                VkResult result = vkCreateBuffer(device, &bufferInformation, nullptr, &constantBuffer);
-                Logger_ThrowIfFailed(result, "Failed to create constant buffer!", false);
+            template<typename T>
+            bool UpdateConstantBuffer(VkCommandBuffer commandBuffer, const T& data) const
+            {
+                if (!hasConstantBuffer)
+                    return true;
 
-                VkMemoryRequirements memoryRequirements;
-                vkGetBufferMemoryRequirements(device, constantBuffer, &memoryRequirements);
+                if (!isConstantBufferDynamic)
+                {
+                    if (!hasReportedStaticConstantBuffer.exchange(true))
+                        Logger_WriteConsole(Formatter::Format("Shader '{}' does not declare binding {} as a dynamic uniform buffer, per-object constants are dropped", name, CONSTANT_BUFFER_BINDING), LogLevel::WARNING);
 
-                VkMemoryAllocateInfo allocationInformation{};
+                    return false;
+                }
 
-                allocationInformation.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-                allocationInformation.allocationSize = memoryRequirements.size;
-                allocationInformation.memoryTypeIndex = VulkanHelper::FindMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+                uint dynamicOffset = UniformRingBuffer::GetInstance()->Allocate(data);
 
-                result = vkAllocateMemory(device, &allocationInformation, nullptr, &constantBufferMemory);
-                Logger_ThrowIfFailed(result, "Failed to allocate constant buffer memory!", false);
+                if (dynamicOffset == UniformRingBuffer::INVALID_OFFSET)
+                    return false;
 
-                vkBindBufferMemory(device, constantBuffer, constantBufferMemory, 0);
+                const auto& descriptorSets = descriptorManager->GetDescriptorSets();
+                vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(), 1, &dynamicOffset);
 
-                Vector<VkBuffer> buffers = { constantBuffer };
-                descriptorManager->CreateDescriptorSets(buffers, bufferSize);
+                return true;
+            }
+
+            template<typename T>
+            bool HasPushConstants(uint offset = 0) const
+            {
+                return GetPushConstantStages(offset, static_cast<uint>(sizeof(T))) != 0;
             }
 
             template<typename T>
-            void UpdateConstantBuffer(const T& data)
+            void PushConstants(VkCommandBuffer commandBuffer, const T& data, uint offset = 0) const
             {
-                void* mappedData;
+                static_assert(sizeof(T) % 4 == 0, "Push constant data must be a multiple of four bytes");
+
+                VkShaderStageFlags stages = GetPushConstantStages(offset, static_cast<uint>(sizeof(T)));
 
-                vkMapMemory(Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice"), constantBufferMemory, 0, sizeof(T), 0, &mappedData);
+                if (stages == 0)
+                    return;
 
-                memcpy(mappedData, &data, sizeof(T));
+                vkCmdPushConstants(commandBuffer, pipelineLayout, stages, offset, static_cast<uint>(sizeof(T)), &data);
+            }
 
-                vkUnmapMemory(Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice"), constantBufferMemory);
+            const Vector<VkPushConstantRange>& GetPushConstantRanges() const
+            {
+                return pushConstantRanges;
             }
 
 			String GetName() const
@@ -263,9 +199,19 @@ namespace RenderVulkan
 				return { vertexShaderModule, fragmentShaderModule };
 			}
 
+			VkShaderModule GetDepthVertexModule() const
+			{
+				return depthVertexShaderModule;
+			}
+
 			VkPipeline GetPipeline() const
 			{
-				return pipeline;
+				return PipelineStateCache::Resolve(pipeline);
+			}
+
+			VkPipeline GetDepthPipeline() const
+			{
+				return PipelineStateCache::Resolve(depthPipeline);
 			}
 
 			VkPipelineLayout GetPipelineLayout() const
@@ -273,27 +219,146 @@ namespace RenderVulkan
 				return pipelineLayout;
 			}
 
-			void CleanUp() const
+			const ShaderReflection& GetReflection() const
 			{
-				vkDeviceWaitIdle(Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice"));
+				return reflection;
+			}
+
+			const ShaderVariantKey& GetVariant() const
+			{
+				return variant;
+			}
+
+			bool IsVariant() const
+			{
+				return isVariant;
+			}
+
+			bool IsBindless() const
+			{
+				return isBindless;
+			}
+
+			bool UsesFile(const Path& path) const
+			{
+				Path normalizedPath = path.lexically_normal();
+
+				return Path(vertexPath).lexically_normal() == normalizedPath || Path(fragmentPath).lexically_normal() == normalizedPath || Path(depthVertexPath).lexically_normal() == normalizedPath;
+			}
+
+			Shared<Shader> Reload(VkRenderPass renderPass, VkRenderPass depthRenderPass) const
+			{
+				if (!std::filesystem::exists(vertexPath) || !std::filesystem::exists(fragmentPath))
+					return nullptr;
+
+				class EnabledShader : public Shader { };
+				Shared<Shader> staging = std::make_shared<EnabledShader>();
+
+				staging->name = name;
+				staging->localPath = localPath;
+				staging->domain = domain;
+				staging->vertexPath = vertexPath;
+				staging->fragmentPath = fragmentPath;
+				staging->depthVertexPath = depthVertexPath;
+				staging->vertexData = FileHelper::ReadFileIntoVector(vertexPath);
+				staging->fragmentData = FileHelper::ReadFileIntoVector(fragmentPath);
+
+				if (std::filesystem::exists(depthVertexPath))
+					staging->depthVertexData = FileHelper::ReadFileIntoVector(depthVertexPath);
+
+				staging->Reflect();
+
+				if (!staging->reflection.IsValid())
+					return nullptr;
+
+				if (!AreBindingsEqual(staging->reflection.GetBindings(0), reflection.GetBindings(0)))
+				{
+					Logger_WriteConsole(Formatter::Format("Shader '{}' changed its descriptor set layout, restart to apply", name), LogLevel::WARNING);
+					return nullptr;
+				}
+
+				staging->descriptorManager->CreateDescriptorSetLayout(descriptorManager->GetBindings());
+				staging->Generate();
+
+				if (pipeline)
+					staging->CreatePipeline(renderPass);
+
+				if (depthPipeline && depthRenderPass != VK_NULL_HANDLE)
+					staging->CreateDepthPipeline(depthRenderPass);
+
+				return staging;
+			}
+
+			Shared<Shader> ReloadVariant(const Shared<Shader>& source, VkRenderPass renderPass, VkRenderPass depthRenderPass) const
+			{
+				Shared<Shader> staging = CreateVariant(source, variant);
+
+				staging->descriptorManager->CreateDescriptorSetLayout(descriptorManager->GetBindings());
+
+				if (pipeline)
+					staging->CreatePipeline(renderPass);
+
+				if (depthPipeline && depthRenderPass != VK_NULL_HANDLE)
+					staging->CreateDepthPipeline(depthRenderPass);
+
+				return staging;
+			}
+
+			void ApplyReload(const Shared<Shader>& staging)
+			{
+				std::swap(vertexData, staging->vertexData);
+				std::swap(fragmentData, staging->fragmentData);
+				std::swap(depthVertexData, staging->depthVertexData);
+
+				std::swap(vertexShaderModule, staging->vertexShaderModule);
+				std::swap(fragmentShaderModule, staging->fragmentShaderModule);
+				std::swap(depthVertexShaderModule, staging->depthVertexShaderModule);
+
+				std::swap(reflection, staging->reflection);
+				std::swap(vertexReflection, staging->vertexReflection);
+				std::swap(depthVertexReflection, staging->depthVertexReflection);
+				std::swap(pushConstantRanges, staging->pushConstantRanges);
+
+				std::swap(pipeline, staging->pipeline);
+				std::swap(depthPipeline, staging->depthPipeline);
+				std::swap(dynamicState, staging->dynamicState);
+				std::swap(depthDynamicState, staging->depthDynamicState);
+				std::swap(pipelineLayout, staging->pipelineLayout);
+
+				PipelineStateCache::GetInstance()->Evict({ staging->vertexShaderModule, staging->fragmentShaderModule, staging->depthVertexShaderModule });
+
+				TimelineScheduler::GetInstance()->OnLastSubmittedComplete([staging]()
+				{
+					staging->DestroyModules();
+				});
+
+				ChangeTracker::GetInstance()->Invalidate();
+
+				Logger_WriteConsole(Formatter::Format("Reloaded shader '{}'", name), LogLevel::INFORMATION);
+			}
+
+			void DestroyModules() const
+			{
+				if (isVariant)
+					return;
+
+				VkDevice device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
 
 				if (vertexShaderModule != VK_NULL_HANDLE)
-					vkDestroyShaderModule(Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice"), vertexShaderModule, nullptr);
-				
-				if (fragmentShaderModule != VK_NULL_HANDLE) 
-					vkDestroyShaderModule(Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice"), fragmentShaderModule, nullptr);
+					vkDestroyShaderModule(device, vertexShaderModule, nullptr);
 
-                if (pipeline != VK_NULL_HANDLE)
-                    vkDestroyPipeline(Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice"), pipeline, nullptr);
+				if (fragmentShaderModule != VK_NULL_HANDLE)
+					vkDestroyShaderModule(device, fragmentShaderModule, nullptr);
 
-                if (pipelineLayout != VK_NULL_HANDLE)
-                    vkDestroyPipelineLayout(Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice"), pipelineLayout, nullptr);
+				if (depthVertexShaderModule != VK_NULL_HANDLE)
+					vkDestroyShaderModule(device, depthVertexShaderModule, nullptr);
+			}
 
-                if (constantBuffer != VK_NULL_HANDLE)
-					vkDestroyBuffer(Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice"), constantBuffer, nullptr);
+			void CleanUp() const
+			{
+				vkDeviceWaitIdle(Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice"));
 
-                if (constantBufferMemory != VK_NULL_HANDLE)
-                    vkFreeMemory(Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice"), constantBufferMemory, nullptr);
+				DestroyModules();
 
                 if (descriptorManager)
                     descriptorManager->CleanUp();
@@ -309,23 +374,243 @@ namespace RenderVulkan
 				shader->domain = domain;
 				shader->vertexPath = Formatter::Format("Assets/{}/{}Vertex.spv", domain, localPath);
 				shader->fragmentPath = Formatter::Format("Assets/{}/{}Fragment.spv", domain, localPath);
+				shader->depthVertexPath = Formatter::Format("Assets/{}/{}DepthVertex.spv", domain, localPath);
 				shader->vertexData = FileHelper::ReadFileIntoVector(shader->vertexPath);
 				shader->fragmentData = FileHelper::ReadFileIntoVector(shader->fragmentPath);
+
+				if (std::filesystem::exists(shader->depthVertexPath))
+					shader->depthVertexData = FileHelper::ReadFileIntoVector(shader->depthVertexPath);
+
+				shader->Reflect();
+
                 shader->descriptorManager = std::move(descriptorManager);
+				shader->ValidateDescriptorManager();
+
+                if (shader->descriptorManager->GetDescriptorSetLayout() != VK_NULL_HANDLE)
+                    shader->descriptorManager->CreateDescriptorSetLayout(GetDynamicConstantBufferBindings(shader->descriptorManager->GetBindings()));
 
 				shader->Generate();
 
 				return shader;
 			}
 
+			static Shared<Shader> Create(const String& localPath, const String& name, const String& domain = Settings::GetInstance()->Get<String>("defaultDomain"))
+			{
+				Shared<Shader> shader = Create(localPath, name, DescriptorManager::Create(), domain);
+
+				shader->CreateReflectedDescriptorManager();
+
+				return shader;
+			}
+
+			static Shared<Shader> Create(const Shared<Shader>& source, const ShaderVariantKey& variant)
+			{
+				Shared<Shader> shader = CreateVariant(source, variant);
+
+				shader->descriptorManager->CreateDescriptorSetLayout(source->descriptorManager->GetBindings());
+
+				return shader;
+			}
+
 		private:
 
 			Shader() = default;
 
+            void CreatePipelineLayout()
+            {
+                if (pipelineLayout != VK_NULL_HANDLE)
+                    return;
+
+                Vector<VkDescriptorSetLayout> setLayouts = { isBindless ? BindlessManager::GetInstance()->GetDescriptorSetLayout() : descriptorManager->GetDescriptorSetLayout() };
+
+                for (uint set = 1; set < reflection.GetSetCount(); set++)
+                    setLayouts.push_back(LayoutCache::GetInstance()->GetDescriptorSetLayout(reflection.GetBindings(set)));
+
+                const Vector<VkPushConstantRange>& reflectedRanges = reflection.GetPushConstantRanges();
+
+                if (isBindless && !reflectedRanges.empty() && reflectedRanges.front().offset + reflectedRanges.front().size > BindlessManager::PUSH_CONSTANT_SIZE)
+                    Logger_WriteConsole(Formatter::Format("Shader '{}' uses more than '{}' bytes of push constants, which bindless pipelines do not reserve", name, BindlessManager::PUSH_CONSTANT_SIZE), LogLevel::WARNING);
+
+                pipelineLayout = LayoutCache::GetInstance()->GetPipelineLayout(setLayouts, pushConstantRanges);
+            }
+
+            VkShaderStageFlags GetPushConstantStages(uint offset, uint size) const
+            {
+                VkShaderStageFlags stages = 0;
+                bool isCovered = false;
+
+                for (const VkPushConstantRange& range : pushConstantRanges)
+                {
+                    if (offset < range.offset + range.size && range.offset < offset + size)
+                        stages |= range.stageFlags;
+
+                    if (range.offset <= offset && offset + size <= range.offset + range.size)
+                        isCovered = true;
+                }
+
+                return isCovered ? stages : 0;
+            }
+
+            void BindDescriptorSets(VkCommandBuffer commandBuffer) const
+            {
+                if (isBindless)
+                {
+                    BindlessManager::GetInstance()->Bind(commandBuffer, pipelineLayout);
+                    return;
+                }
+
+                BindlessManager::GetInstance()->Invalidate();
+
+                const auto& descriptorSets = descriptorManager->GetDescriptorSets();
+
+                if (isConstantBufferDynamic || descriptorSets.empty())
+                    return;
+
+                vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
+            }
+
+            void Reflect()
+            {
+                vertexReflection = ShaderReflection::Reflect(vertexData);
+
+                reflection = vertexReflection;
+                reflection.Merge(ShaderReflection::Reflect(fragmentData));
+
+                if (!depthVertexData.empty())
+                {
+                    depthVertexReflection = ShaderReflection::Reflect(depthVertexData);
+                    reflection.Merge(depthVertexReflection);
+                }
+
+                isBindless = reflection.HasRuntimeDescriptorArrays(BindlessManager::SET_INDEX);
+
+                if (isBindless && !BindlessManager::GetInstance()->IsEnabled())
+                {
+                    Logger_ThrowException(Formatter::Format("Shader '{}' indexes runtime descriptor arrays, which need bindless descriptors (--bindless)", name), false);
+
+                    reflection.Invalidate();
+                    isBindless = false;
+                }
+
+                if (isBindless)
+                    pushConstantRanges = { BindlessManager::GetInstance()->GetPushConstantRange() };
+                else
+                    pushConstantRanges = reflection.GetPushConstantRanges();
+            }
+
+            static Shared<Shader> CreateVariant(const Shared<Shader>& source, const ShaderVariantKey& variant)
+            {
+                class EnabledShader : public Shader { };
+                Shared<Shader> shader = std::make_shared<EnabledShader>();
+
+                shader->name = Formatter::Format("{}[{}]", source->name, variant.ToString());
+                shader->localPath = source->localPath;
+                shader->domain = source->domain;
+                shader->vertexPath = source->vertexPath;
+                shader->fragmentPath = source->fragmentPath;
+                shader->depthVertexPath = source->depthVertexPath;
+
+                shader->vertexShaderModule = source->vertexShaderModule;
+                shader->fragmentShaderModule = source->fragmentShaderModule;
+                shader->depthVertexShaderModule = source->depthVertexShaderModule;
+
+                shader->reflection = source->reflection;
+                shader->vertexReflection = source->vertexReflection;
+                shader->depthVertexReflection = source->depthVertexReflection;
+
+                shader->variant = source->variant;
+                shader->isVariant = true;
+                shader->isBindless = source->isBindless;
+                shader->pushConstantRanges = source->pushConstantRanges;
+
+                for (const auto& [constantId, value] : variant.constants)
+                    shader->variant.Set(constantId, value);
+
+                shader->ValidateVariant();
+
+                return shader;
+            }
+
+            void ValidateVariant()
+            {
+                const Map<uint, uint>& declared = reflection.GetSpecializationConstants();
+
+                std::erase_if(variant.constants, [this, &declared](const Pair<const uint, uint>& constant)
+                {
+                    if (!declared.contains(constant.first))
+                    {
+                        Logger_WriteConsole(Formatter::Format("Shader '{}' declares no specialization constant '{}', ignoring it", name, constant.first), LogLevel::WARNING);
+                        return true;
+                    }
+
+                    if (declared.at(constant.first) != sizeof(uint))
+                    {
+                        Logger_WriteConsole(Formatter::Format("Shader '{}' specialization constant '{}' is not 32 bits wide, ignoring it", name, constant.first), LogLevel::WARNING);
+                        return true;
+                    }
+
+                    return false;
+                });
+            }
+
+            void CreateReflectedDescriptorManager()
+            {
+                if (isBindless || !reflection.IsValid())
+                    return;
+
+                descriptorManager->CreateDescriptorSetLayout(GetDynamicConstantBufferBindings(reflection.GetBindings(0)));
+            }
+
+            static Vector<VkDescriptorSetLayoutBinding> GetDynamicConstantBufferBindings(Vector<VkDescriptorSetLayoutBinding> bindings)
+            {
+                for (VkDescriptorSetLayoutBinding& binding : bindings)
+                {
+                    if (binding.binding == CONSTANT_BUFFER_BINDING && binding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+                        binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+                }
+
+                return bindings;
+            }
+
+            static bool AreBindingsEqual(const Vector<VkDescriptorSetLayoutBinding>& left, const Vector<VkDescriptorSetLayoutBinding>& right)
+            {
+                if (left.size() != right.size())
+                    return false;
+
+                for (Size b = 0; b < left.size(); b++)
+                {
+                    if (left[b].binding != right[b].binding || left[b].descriptorType != right[b].descriptorType || left[b].descriptorCount != right[b].descriptorCount || left[b].stageFlags != right[b].stageFlags)
+                        return false;
+                }
+
+                return true;
+            }
+
+            void ValidateDescriptorManager() const
+            {
+                if (descriptorManager->GetDescriptorSetLayout() == VK_NULL_HANDLE)
+                    return;
+
+                const Vector<VkDescriptorSetLayoutBinding>& declared = descriptorManager->GetBindings();
+
+                for (const VkDescriptorSetLayoutBinding& reflected : reflection.GetBindings(0))
+                {
+                    auto iterator = std::find_if(declared.begin(), declared.end(), [&reflected](const VkDescriptorSetLayoutBinding& binding) { return binding.binding == reflected.binding; });
+
+                    if (iterator == declared.end())
+                        Logger_WriteConsole(Formatter::Format("Shader '{}' uses binding '{}', which its descriptor set layout does not declare", name, reflected.binding), LogLevel::WARNING);
+                    else if ((iterator->descriptorType != reflected.descriptorType && !(iterator->descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC && reflected.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)) || iterator->descriptorCount < reflected.descriptorCount || (iterator->stageFlags & reflected.stageFlags) != reflected.stageFlags)
+                        Logger_WriteConsole(Formatter::Format("Shader '{}' binding '{}' does not match its declared descriptor set layout", name, reflected.binding), LogLevel::WARNING);
+                }
+            }
+
 			void Generate()
 			{
 				vertexShaderModule = CreateShaderModule(vertexData);
 				fragmentShaderModule = CreateShaderModule(fragmentData);
+
+				if (!depthVertexData.empty())
+					depthVertexShaderModule = CreateShaderModule(depthVertexData);
 			}
 
 			VkShaderModule CreateShaderModule(const Vector<char>& code)
@@ -354,16 +639,33 @@ namespace RenderVulkan
 			String fragmentPath;
 			Vector<char> fragmentData;
 
+			String depthVertexPath;
+			Vector<char> depthVertexData;
+
 			VkShaderModule vertexShaderModule = VK_NULL_HANDLE;
 			VkShaderModule fragmentShaderModule = VK_NULL_HANDLE;
+			VkShaderModule depthVertexShaderModule = VK_NULL_HANDLE;
 
-            VkPipeline pipeline = VK_NULL_HANDLE;
+            PipelineSlot pipeline;
+            PipelineSlot depthPipeline;
+            PipelineDynamicState dynamicState;
+            PipelineDynamicState depthDynamicState;
             VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
 
             Unique<DescriptorManager> descriptorManager = DescriptorManager::Create();
 
-            VkBuffer constantBuffer = VK_NULL_HANDLE;
-            VkDeviceMemory constantBufferMemory = VK_NULL_HANDLE;
+            ShaderReflection reflection;
+            ShaderReflection vertexReflection;
+            ShaderReflection depthVertexReflection;
+
+            ShaderVariantKey variant;
+            bool isVariant = false;
+            bool isBindless = false;
+            bool hasConstantBuffer = false;
+            bool isConstantBufferDynamic = false;
+            mutable Atomic<bool> hasReportedStaticConstantBuffer = false;
+
+            Vector<VkPushConstantRange> pushConstantRanges;
 		};
 	}
 }
\ No newline at end of file
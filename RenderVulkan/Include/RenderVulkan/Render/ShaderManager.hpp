@@ -1,8 +1,11 @@
 #pragma once
 
+#include "RenderVulkan/Core/Logger.hpp"
 #include "RenderVulkan/Render/Shader.hpp"
+#include "RenderVulkan/Util/FileWatcher.hpp"
 #include "RenderVulkan/Util/Typedefs.hpp"
 
+using namespace RenderVulkan::Core;
 using namespace RenderVulkan::Util;
 
 namespace RenderVulkan
@@ -19,29 +22,154 @@ namespace RenderVulkan
 
 			void Register(Shared<Shader> shader)
 			{
+				LockGuard<Mutex> lock(mutex);
+
 				registeredShaders[shader->GetName()] = shader;
 			}
 
 			void Unregister(const String& name)
 			{
+				LockGuard<Mutex> lock(mutex);
+
 				registeredShaders.erase(name);
 			}
 
 			void CreateShaderGraphicsPipelines(VkRenderPass renderPass)
 			{
+				LockGuard<Mutex> lock(mutex);
+
+				graphicsRenderPass = renderPass;
+
 				for (auto& [name, shader] : registeredShaders)
 					shader->CreatePipeline(renderPass);
+
+				for (auto& [name, shaderVariants] : variants)
+				{
+					for (auto& [variant, shader] : shaderVariants)
+						shader->CreatePipeline(renderPass);
+				}
+			}
+
+			void CreateShaderDepthPipelines(VkRenderPass renderPass)
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				depthRenderPass = renderPass;
+
+				for (auto& [name, shader] : registeredShaders)
+					shader->CreateDepthPipeline(renderPass);
+
+				for (auto& [name, shaderVariants] : variants)
+				{
+					for (auto& [variant, shader] : shaderVariants)
+						shader->CreateDepthPipeline(renderPass);
+				}
 			}
 
 			Shared<Shader> Get(const String& name)
 			{
+				LockGuard<Mutex> lock(mutex);
+
 				return registeredShaders[name];
 			}
 
+			Shared<Shader> GetVariant(const String& name, const ShaderVariantKey& variant)
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				if (!registeredShaders.contains(name))
+				{
+					Logger_ThrowException(Formatter::Format("Shader '{}' is not registered", name), false);
+					return nullptr;
+				}
+
+				if (variant.IsEmpty())
+					return registeredShaders[name];
+
+				for (const auto& [cachedVariant, cachedShader] : variants[name])
+				{
+					if (cachedVariant == variant)
+						return cachedShader;
+				}
+
+				Shared<Shader> shader = Shader::Create(registeredShaders[name], variant);
+
+				if (graphicsRenderPass != VK_NULL_HANDLE)
+					shader->CreatePipeline(graphicsRenderPass);
+
+				if (depthRenderPass != VK_NULL_HANDLE)
+					shader->CreateDepthPipeline(depthRenderPass);
+
+				variants[name].push_back({ variant, shader });
+
+				return shader;
+			}
+
+			void EnableHotReload(Milliseconds interval = Milliseconds(250))
+			{
+				Vector<Path> directories;
+				std::error_code error;
+
+				for (const DirectoryEntry& entry : DirectoryIterator("Assets", error))
+				{
+					if (std::filesystem::is_directory(entry.path() / "Shader", error))
+						directories.push_back(entry.path() / "Shader");
+				}
+
+				if (directories.empty())
+				{
+					Logger_WriteConsole("No 'Assets/*/Shader' directories found, shader hot reload disabled", LogLevel::WARNING);
+					return;
+				}
+
+				fileWatcher = FileWatcher::Create();
+				fileWatcher->Start(directories, ".spv", interval, [this](const Vector<Path>& changedFiles)
+				{
+					LockGuard<Mutex> lock(reloadMutex);
+
+					pendingFiles.insert(pendingFiles.end(), changedFiles.begin(), changedFiles.end());
+				});
+
+				Logger_WriteConsole(Formatter::Format("Watching '{}' shader directories for changes", directories.size()), LogLevel::INFORMATION);
+			}
+
+			void Update()
+			{
+				Vector<Path> changedFiles;
+
+				{
+					LockGuard<Mutex> lock(reloadMutex);
+
+					if (pendingFiles.empty())
+						return;
+
+					changedFiles.swap(pendingFiles);
+				}
+
+				ReloadChanged(changedFiles);
+			}
+
 			void CleanUp()
 			{
+				if (fileWatcher)
+					fileWatcher->Stop();
+
+				{
+					LockGuard<Mutex> lock(reloadMutex);
+
+					pendingFiles.clear();
+				}
+
+				for (auto& [name, shaderVariants] : variants)
+				{
+					for (auto& [variant, shader] : shaderVariants)
+						shader->CleanUp();
+				}
+
 				for (auto& [name, shader] : registeredShaders)
 					shader->CleanUp();
+
+				variants.clear();
 			}
 
 			static Shared<ShaderManager> GetInstance()
@@ -56,8 +184,64 @@ namespace RenderVulkan
 
 			ShaderManager() = default;
 
+			Vector<Shared<Shader>> GetVariants(const String& name)
+			{
+				LockGuard<Mutex> lock(mutex);
+
+				Vector<Shared<Shader>> shaders;
+
+				if (!variants.contains(name))
+					return shaders;
+
+				for (const auto& [variant, shader] : variants.at(name))
+					shaders.push_back(shader);
+
+				return shaders;
+			}
+
+			void ReloadChanged(const Vector<Path>& changedFiles)
+			{
+				Vector<Shared<Shader>> affectedShaders;
+
+				{
+					LockGuard<Mutex> lock(mutex);
+
+					for (const auto& [name, shader] : registeredShaders)
+					{
+						if (std::any_of(changedFiles.begin(), changedFiles.end(), [&shader](const Path& path) { return shader->UsesFile(path); }))
+							affectedShaders.push_back(shader);
+					}
+				}
+
+				for (const Shared<Shader>& shader : affectedShaders)
+				{
+					Shared<Shader> staging = shader->Reload(graphicsRenderPass, depthRenderPass);
+
+					if (!staging)
+					{
+						Logger_WriteConsole(Formatter::Format("Failed to reload shader '{}', keeping the previous version", shader->GetName()), LogLevel::WARNING);
+						continue;
+					}
+
+					shader->ApplyReload(staging);
+
+					for (const Shared<Shader>& variant : GetVariants(shader->GetName()))
+						variant->ApplyReload(variant->ReloadVariant(shader, graphicsRenderPass, depthRenderPass));
+				}
+			}
+
+			Mutex mutex;
 			UnorderedMap<String, Shared<Shader>> registeredShaders;
+			UnorderedMap<String, Vector<Pair<ShaderVariantKey, Shared<Shader>>>> variants;
+
+			VkRenderPass graphicsRenderPass = VK_NULL_HANDLE;
+			VkRenderPass depthRenderPass = VK_NULL_HANDLE;
+
+			Unique<FileWatcher> fileWatcher;
+
+			Mutex reloadMutex;
+			Vector<Path> pendingFiles;
 
 		};
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,755 @@
+#pragma once
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Util/Formatter.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+using namespace RenderVulkan::Core;
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		struct ReflectedVertexInput
+		{
+			uint location = 0;
+			VkFormat format = VK_FORMAT_UNDEFINED;
+		};
+
+		class ShaderReflection
+		{
+
+		public:
+
+			ShaderReflection() = default;
+
+			bool IsValid() const
+			{
+				return isValid;
+			}
+
+			void Invalidate()
+			{
+				isValid = false;
+			}
+
+			VkShaderStageFlags GetStages() const
+			{
+				return stages;
+			}
+
+			const Map<uint, Vector<VkDescriptorSetLayoutBinding>>& GetDescriptorSets() const
+			{
+				return descriptorSets;
+			}
+
+			Vector<VkDescriptorSetLayoutBinding> GetBindings(uint set) const
+			{
+				if (!descriptorSets.contains(set))
+					return {};
+
+				return descriptorSets.at(set);
+			}
+
+			bool HasRuntimeDescriptorArrays(uint set) const
+			{
+				Vector<VkDescriptorSetLayoutBinding> bindings = GetBindings(set);
+
+				return std::any_of(bindings.begin(), bindings.end(), [](const VkDescriptorSetLayoutBinding& binding) { return binding.descriptorCount == 0; });
+			}
+
+			uint GetSetCount() const
+			{
+				return descriptorSets.empty() ? 0 : descriptorSets.rbegin()->first + 1;
+			}
+
+			Vector<VkDescriptorPoolSize> GetPoolSizes(uint set, uint setCount) const
+			{
+				return GetPoolSizes(GetBindings(set), setCount);
+			}
+
+			static Vector<VkDescriptorPoolSize> GetPoolSizes(const Vector<VkDescriptorSetLayoutBinding>& bindings, uint setCount)
+			{
+				Map<VkDescriptorType, uint> counts;
+
+				for (const VkDescriptorSetLayoutBinding& binding : bindings)
+					counts[binding.descriptorType] += binding.descriptorCount * setCount;
+
+				Vector<VkDescriptorPoolSize> poolSizes;
+
+				for (const auto& [type, count] : counts)
+					poolSizes.push_back({ type, count });
+
+				return poolSizes;
+			}
+
+			const Vector<VkPushConstantRange>& GetPushConstantRanges() const
+			{
+				return pushConstantRanges;
+			}
+
+			const Map<uint, uint>& GetSpecializationConstants() const
+			{
+				return specializationConstants;
+			}
+
+			const Vector<ReflectedVertexInput>& GetVertexInputs() const
+			{
+				return vertexInputs;
+			}
+
+			Vector<VkVertexInputAttributeDescription> SelectVertexAttributes(const Vector<VkVertexInputAttributeDescription>& available) const
+			{
+				Vector<VkVertexInputAttributeDescription> attributes;
+
+				for (const ReflectedVertexInput& input : vertexInputs)
+				{
+					auto iterator = std::find_if(available.begin(), available.end(), [&input](const VkVertexInputAttributeDescription& attribute) { return attribute.location == input.location; });
+
+					if (iterator == available.end())
+					{
+						Logger_ThrowException(Formatter::Format("Shader reads vertex location '{}', which the vertex layout does not provide", input.location), false);
+						continue;
+					}
+
+					if (iterator->format != input.format)
+						Logger_WriteConsole(Formatter::Format("Vertex location '{}' has format '{}' in the shader but '{}' in the vertex layout", input.location, static_cast<int>(input.format), static_cast<int>(iterator->format)), LogLevel::WARNING);
+
+					attributes.push_back(*iterator);
+				}
+
+				return attributes;
+			}
+
+			void Merge(const ShaderReflection& other)
+			{
+				isValid = isValid && other.isValid;
+				stages |= other.stages;
+
+				for (const auto& [set, bindings] : other.descriptorSets)
+				{
+					for (const VkDescriptorSetLayoutBinding& binding : bindings)
+						AddBinding(set, binding);
+				}
+
+				for (const VkPushConstantRange& range : other.pushConstantRanges)
+					AddPushConstantRange(range);
+
+				specializationConstants.insert(other.specializationConstants.begin(), other.specializationConstants.end());
+
+				if (vertexInputs.empty())
+					vertexInputs = other.vertexInputs;
+			}
+
+			static ShaderReflection Reflect(const Vector<char>& code)
+			{
+				ShaderReflection reflection;
+
+				reflection.isValid = false;
+
+				if (code.size() < 5 * sizeof(uint) || code.size() % sizeof(uint) != 0)
+				{
+					Logger_ThrowException("SPIR-V module is truncated", false);
+					return reflection;
+				}
+
+				Vector<uint> words(code.size() / sizeof(uint));
+				std::memcpy(words.data(), code.data(), code.size());
+
+				if (words[0] != SPIRV_MAGIC)
+				{
+					Logger_ThrowException("SPIR-V module has an invalid magic number", false);
+					return reflection;
+				}
+
+				Parser parser;
+
+				for (Size w = 5; w < words.size();)
+				{
+					uint wordCount = words[w] >> 16;
+					uint opcode = words[w] & 0xFFFF;
+
+					if (wordCount == 0 || w + wordCount > words.size())
+					{
+						Logger_ThrowException("SPIR-V module contains a malformed instruction", false);
+						return reflection;
+					}
+
+					parser.Parse(opcode, &words[w + 1], wordCount - 1);
+
+					w += wordCount;
+				}
+
+				parser.Build(reflection);
+
+				reflection.isValid = true;
+
+				return reflection;
+			}
+
+		private:
+
+			static constexpr uint SPIRV_MAGIC = 0x07230203;
+
+			static constexpr uint OP_ENTRY_POINT = 15;
+			static constexpr uint OP_TYPE_BOOL = 20;
+			static constexpr uint OP_TYPE_INT = 21;
+			static constexpr uint OP_TYPE_FLOAT = 22;
+			static constexpr uint OP_TYPE_VECTOR = 23;
+			static constexpr uint OP_TYPE_MATRIX = 24;
+			static constexpr uint OP_TYPE_IMAGE = 25;
+			static constexpr uint OP_TYPE_SAMPLER = 26;
+			static constexpr uint OP_TYPE_SAMPLED_IMAGE = 27;
+			static constexpr uint OP_TYPE_ARRAY = 28;
+			static constexpr uint OP_TYPE_RUNTIME_ARRAY = 29;
+			static constexpr uint OP_TYPE_STRUCT = 30;
+			static constexpr uint OP_TYPE_POINTER = 32;
+			static constexpr uint OP_CONSTANT = 43;
+			static constexpr uint OP_SPEC_CONSTANT_TRUE = 48;
+			static constexpr uint OP_SPEC_CONSTANT_FALSE = 49;
+			static constexpr uint OP_SPEC_CONSTANT = 50;
+			static constexpr uint OP_VARIABLE = 59;
+			static constexpr uint OP_DECORATE = 71;
+			static constexpr uint OP_MEMBER_DECORATE = 72;
+			static constexpr uint OP_TYPE_ACCELERATION_STRUCTURE = 5341;
+
+			static constexpr uint DECORATION_SPEC_ID = 1;
+			static constexpr uint DECORATION_BLOCK = 2;
+			static constexpr uint DECORATION_BUFFER_BLOCK = 3;
+			static constexpr uint DECORATION_ARRAY_STRIDE = 6;
+			static constexpr uint DECORATION_MATRIX_STRIDE = 7;
+			static constexpr uint DECORATION_BUILT_IN = 11;
+			static constexpr uint DECORATION_LOCATION = 30;
+			static constexpr uint DECORATION_BINDING = 33;
+			static constexpr uint DECORATION_DESCRIPTOR_SET = 34;
+			static constexpr uint DECORATION_OFFSET = 35;
+
+			static constexpr uint STORAGE_UNIFORM_CONSTANT = 0;
+			static constexpr uint STORAGE_INPUT = 1;
+			static constexpr uint STORAGE_UNIFORM = 2;
+			static constexpr uint STORAGE_PUSH_CONSTANT = 9;
+			static constexpr uint STORAGE_STORAGE_BUFFER = 12;
+
+			struct SpirvType
+			{
+				uint opcode = 0;
+				Vector<uint> operands;
+			};
+
+			struct SpirvDecorations
+			{
+				Optional<uint> set;
+				Optional<uint> binding;
+				Optional<uint> location;
+				Optional<uint> arrayStride;
+				Optional<uint> specializationId;
+				bool isBlock = false;
+				bool isBufferBlock = false;
+				bool isBuiltIn = false;
+
+				Map<uint, uint> memberOffsets;
+				Map<uint, uint> memberMatrixStrides;
+			};
+
+			struct SpirvVariable
+			{
+				uint id = 0;
+				uint pointerType = 0;
+				uint storageClass = 0;
+			};
+
+			class Parser
+			{
+
+			public:
+
+				void Parse(uint opcode, const uint* operands, uint operandCount)
+				{
+					Vector<uint> values(operands, operands + operandCount);
+
+					switch (opcode)
+					{
+
+					case OP_ENTRY_POINT:
+						if (!executionModel.has_value() && operandCount > 0)
+							executionModel = values[0];
+						break;
+
+					case OP_DECORATE:
+						if (operandCount >= 2)
+							Decorate(decorations[values[0]], values[1], operandCount > 2 ? values[2] : 0);
+						break;
+
+					case OP_MEMBER_DECORATE:
+						if (operandCount >= 4 && values[2] == DECORATION_OFFSET)
+							decorations[values[0]].memberOffsets[values[1]] = values[3];
+						else if (operandCount >= 4 && values[2] == DECORATION_MATRIX_STRIDE)
+							decorations[values[0]].memberMatrixStrides[values[1]] = values[3];
+						else if (operandCount >= 3 && values[2] == DECORATION_BUILT_IN)
+							decorations[values[0]].isBuiltIn = true;
+						break;
+
+					case OP_CONSTANT:
+						if (operandCount >= 3)
+							constants[values[1]] = values[2];
+						break;
+
+					case OP_SPEC_CONSTANT_TRUE:
+					case OP_SPEC_CONSTANT_FALSE:
+					case OP_SPEC_CONSTANT:
+						if (operandCount >= 2)
+							specializationConstants.push_back({ values[1], values[0] });
+						break;
+
+					case OP_VARIABLE:
+						if (operandCount >= 3)
+							variables.push_back({ values[1], values[0], values[2] });
+						break;
+
+					case OP_TYPE_BOOL:
+					case OP_TYPE_INT:
+					case OP_TYPE_FLOAT:
+					case OP_TYPE_VECTOR:
+					case OP_TYPE_MATRIX:
+					case OP_TYPE_IMAGE:
+					case OP_TYPE_SAMPLER:
+					case OP_TYPE_SAMPLED_IMAGE:
+					case OP_TYPE_ARRAY:
+					case OP_TYPE_RUNTIME_ARRAY:
+					case OP_TYPE_STRUCT:
+					case OP_TYPE_POINTER:
+					case OP_TYPE_ACCELERATION_STRUCTURE:
+						if (operandCount >= 1)
+							types[values[0]] = { opcode, Vector<uint>(values.begin() + 1, values.end()) };
+						break;
+
+					default:
+						break;
+					}
+				}
+
+				void Build(ShaderReflection& reflection) const
+				{
+					VkShaderStageFlags stage = GetStage();
+
+					reflection.stages = stage;
+
+					for (const SpirvVariable& variable : variables)
+					{
+						const SpirvType* pointer = FindType(variable.pointerType);
+
+						if (pointer == nullptr || pointer->opcode != OP_TYPE_POINTER || pointer->operands.size() < 2)
+							continue;
+
+						uint pointee = pointer->operands[1];
+						const SpirvDecorations& variableDecorations = GetDecorations(variable.id);
+
+						switch (variable.storageClass)
+						{
+
+						case STORAGE_UNIFORM_CONSTANT:
+						case STORAGE_UNIFORM:
+						case STORAGE_STORAGE_BUFFER:
+						{
+							if (!variableDecorations.binding.has_value())
+								break;
+
+							VkDescriptorSetLayoutBinding binding{};
+
+							binding.binding = *variableDecorations.binding;
+							binding.descriptorCount = 1;
+							binding.stageFlags = stage;
+
+							uint elementType = UnwrapArrays(pointee, binding.descriptorCount);
+
+							binding.descriptorType = GetDescriptorType(elementType, variable.storageClass);
+
+							if (binding.descriptorType == VK_DESCRIPTOR_TYPE_MAX_ENUM)
+							{
+								Logger_WriteConsole(Formatter::Format("Skipping binding '{}' with an unsupported descriptor type", binding.binding), LogLevel::WARNING);
+								break;
+							}
+
+							reflection.AddBinding(variableDecorations.set.value_or(0), binding);
+							break;
+						}
+
+						case STORAGE_PUSH_CONSTANT:
+						{
+							VkPushConstantRange range{};
+
+							range.stageFlags = stage;
+							range.offset = GetMinimumOffset(pointee);
+							range.size = GetTypeSize(pointee) - range.offset;
+
+							if (range.size > 0)
+								reflection.AddPushConstantRange(range);
+
+							break;
+						}
+
+						case STORAGE_INPUT:
+						{
+							if (stage != VK_SHADER_STAGE_VERTEX_BIT || variableDecorations.isBuiltIn || GetDecorations(pointee).isBuiltIn || !variableDecorations.location.has_value())
+								break;
+
+							reflection.vertexInputs.push_back({ *variableDecorations.location, GetVertexFormat(pointee) });
+							break;
+						}
+
+						default:
+							break;
+						}
+					}
+
+					for (const auto& [constantId, typeId] : specializationConstants)
+					{
+						const SpirvDecorations& constantDecorations = GetDecorations(constantId);
+
+						if (constantDecorations.specializationId.has_value())
+							reflection.specializationConstants[*constantDecorations.specializationId] = GetTypeSize(typeId);
+					}
+
+					std::sort(reflection.vertexInputs.begin(), reflection.vertexInputs.end(), [](const ReflectedVertexInput& left, const ReflectedVertexInput& right) { return left.location < right.location; });
+				}
+
+			private:
+
+				static void Decorate(SpirvDecorations& target, uint decoration, uint value)
+				{
+					switch (decoration)
+					{
+
+					case DECORATION_SPEC_ID:
+						target.specializationId = value;
+						break;
+
+					case DECORATION_BLOCK:
+						target.isBlock = true;
+						break;
+
+					case DECORATION_BUFFER_BLOCK:
+						target.isBufferBlock = true;
+						break;
+
+					case DECORATION_ARRAY_STRIDE:
+						target.arrayStride = value;
+						break;
+
+					case DECORATION_BUILT_IN:
+						target.isBuiltIn = true;
+						break;
+
+					case DECORATION_LOCATION:
+						target.location = value;
+						break;
+
+					case DECORATION_BINDING:
+						target.binding = value;
+						break;
+
+					case DECORATION_DESCRIPTOR_SET:
+						target.set = value;
+						break;
+
+					default:
+						break;
+					}
+				}
+
+				VkShaderStageFlags GetStage() const
+				{
+					switch (executionModel.value_or(0))
+					{
+
+					case 0:
+						return VK_SHADER_STAGE_VERTEX_BIT;
+
+					case 1:
+						return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+
+					case 2:
+						return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+
+					case 3:
+						return VK_SHADER_STAGE_GEOMETRY_BIT;
+
+					case 4:
+						return VK_SHADER_STAGE_FRAGMENT_BIT;
+
+					case 5:
+						return VK_SHADER_STAGE_COMPUTE_BIT;
+
+					default:
+						return VK_SHADER_STAGE_ALL;
+					}
+				}
+
+				const SpirvType* FindType(uint id) const
+				{
+					if (!types.contains(id))
+						return nullptr;
+
+					return &types.at(id);
+				}
+
+				const SpirvDecorations& GetDecorations(uint id) const
+				{
+					static const SpirvDecorations empty;
+
+					if (!decorations.contains(id))
+						return empty;
+
+					return decorations.at(id);
+				}
+
+				uint GetConstant(uint id) const
+				{
+					if (!constants.contains(id))
+						return 1;
+
+					return constants.at(id);
+				}
+
+				uint UnwrapArrays(uint typeId, uint& count) const
+				{
+					const SpirvType* type = FindType(typeId);
+
+					while (type != nullptr && (type->opcode == OP_TYPE_ARRAY || type->opcode == OP_TYPE_RUNTIME_ARRAY) && !type->operands.empty())
+					{
+						if (type->opcode == OP_TYPE_ARRAY && type->operands.size() >= 2)
+							count *= GetConstant(type->operands[1]);
+						else
+							count = 0;
+
+						typeId = type->operands[0];
+						type = FindType(typeId);
+					}
+
+					return typeId;
+				}
+
+				VkDescriptorType GetDescriptorType(uint typeId, uint storageClass) const
+				{
+					const SpirvType* type = FindType(typeId);
+
+					if (type == nullptr)
+						return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+
+					if (storageClass == STORAGE_STORAGE_BUFFER)
+						return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+
+					if (storageClass == STORAGE_UNIFORM)
+						return GetDecorations(typeId).isBufferBlock ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+
+					switch (type->opcode)
+					{
+
+					case OP_TYPE_SAMPLER:
+						return VK_DESCRIPTOR_TYPE_SAMPLER;
+
+					case OP_TYPE_SAMPLED_IMAGE:
+						return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+
+					case OP_TYPE_ACCELERATION_STRUCTURE:
+						return VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+
+					case OP_TYPE_IMAGE:
+					{
+						if (type->operands.size() < 6)
+							return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+
+						uint dimension = type->operands[1];
+						uint sampled = type->operands[5];
+
+						if (dimension == 5)
+							return sampled == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+
+						if (dimension == 6)
+							return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+
+						return sampled == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+					}
+
+					default:
+						return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+					}
+				}
+
+				uint GetMinimumOffset(uint structId) const
+				{
+					const SpirvDecorations& structDecorations = GetDecorations(structId);
+
+					if (structDecorations.memberOffsets.empty())
+						return 0;
+
+					uint offset = NumericLimits<uint>::max();
+
+					for (const auto& [member, memberOffset] : structDecorations.memberOffsets)
+						offset = std::min(offset, memberOffset);
+
+					return offset;
+				}
+
+				uint GetTypeSize(uint typeId, uint matrixStride = 0) const
+				{
+					const SpirvType* type = FindType(typeId);
+
+					if (type == nullptr)
+						return 0;
+
+					switch (type->opcode)
+					{
+
+					case OP_TYPE_BOOL:
+						return 4;
+
+					case OP_TYPE_INT:
+					case OP_TYPE_FLOAT:
+						return type->operands.empty() ? 0 : type->operands[0] / 8;
+
+					case OP_TYPE_VECTOR:
+						return type->operands.size() < 2 ? 0 : GetTypeSize(type->operands[0]) * type->operands[1];
+
+					case OP_TYPE_MATRIX:
+						if (type->operands.size() < 2)
+							return 0;
+
+						return (matrixStride > 0 ? matrixStride : GetTypeSize(type->operands[0])) * type->operands[1];
+
+					case OP_TYPE_ARRAY:
+					{
+						if (type->operands.size() < 2)
+							return 0;
+
+						const SpirvDecorations& arrayDecorations = GetDecorations(typeId);
+						uint stride = arrayDecorations.arrayStride.value_or(GetTypeSize(type->operands[0], matrixStride));
+
+						return stride * GetConstant(type->operands[1]);
+					}
+
+					case OP_TYPE_STRUCT:
+					{
+						const SpirvDecorations& structDecorations = GetDecorations(typeId);
+						uint size = 0;
+
+						for (uint m = 0; m < type->operands.size(); m++)
+						{
+							uint offset = structDecorations.memberOffsets.contains(m) ? structDecorations.memberOffsets.at(m) : size;
+							uint stride = structDecorations.memberMatrixStrides.contains(m) ? structDecorations.memberMatrixStrides.at(m) : 0;
+
+							size = std::max(size, offset + GetTypeSize(type->operands[m], stride));
+						}
+
+						return size;
+					}
+
+					default:
+						return 0;
+					}
+				}
+
+				VkFormat GetVertexFormat(uint typeId) const
+				{
+					const SpirvType* type = FindType(typeId);
+
+					if (type == nullptr)
+						return VK_FORMAT_UNDEFINED;
+
+					uint componentCount = 1;
+					const SpirvType* component = type;
+
+					if (type->opcode == OP_TYPE_VECTOR && type->operands.size() >= 2)
+					{
+						componentCount = type->operands[1];
+						component = FindType(type->operands[0]);
+					}
+
+					if (component == nullptr || component->operands.empty() || component->operands[0] != 32)
+						return VK_FORMAT_UNDEFINED;
+
+					static const Array<VkFormat, 4> floatFormats = { VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT };
+					static const Array<VkFormat, 4> signedFormats = { VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT };
+					static const Array<VkFormat, 4> unsignedFormats = { VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT };
+
+					if (componentCount < 1 || componentCount > 4)
+						return VK_FORMAT_UNDEFINED;
+
+					if (component->opcode == OP_TYPE_FLOAT)
+						return floatFormats[componentCount - 1];
+
+					if (component->opcode == OP_TYPE_INT && component->operands.size() >= 2)
+						return component->operands[1] != 0 ? signedFormats[componentCount - 1] : unsignedFormats[componentCount - 1];
+
+					return VK_FORMAT_UNDEFINED;
+				}
+
+				Optional<uint> executionModel;
+
+				UnorderedMap<uint, SpirvType> types;
+				UnorderedMap<uint, SpirvDecorations> decorations;
+				UnorderedMap<uint, uint> constants;
+				Vector<SpirvVariable> variables;
+				Vector<Pair<uint, uint>> specializationConstants;
+
+			};
+
+			void AddBinding(uint set, const VkDescriptorSetLayoutBinding& binding)
+			{
+				Vector<VkDescriptorSetLayoutBinding>& bindings = descriptorSets[set];
+
+				for (VkDescriptorSetLayoutBinding& existing : bindings)
+				{
+					if (existing.binding != binding.binding)
+						continue;
+
+					if (existing.descriptorType != binding.descriptorType)
+					{
+						Logger_ThrowException(Formatter::Format("Descriptor set '{}' binding '{}' is declared with different types across stages", set, binding.binding), false);
+						isValid = false;
+
+						return;
+					}
+
+					existing.descriptorCount = existing.descriptorCount == 0 || binding.descriptorCount == 0 ? 0 : std::max(existing.descriptorCount, binding.descriptorCount);
+					existing.stageFlags |= binding.stageFlags;
+
+					return;
+				}
+
+				bindings.push_back(binding);
+
+				std::sort(bindings.begin(), bindings.end(), [](const VkDescriptorSetLayoutBinding& left, const VkDescriptorSetLayoutBinding& right) { return left.binding < right.binding; });
+			}
+
+			void AddPushConstantRange(const VkPushConstantRange& range)
+			{
+				if (pushConstantRanges.empty())
+				{
+					pushConstantRanges.push_back(range);
+					return;
+				}
+
+				VkPushConstantRange& existing = pushConstantRanges.front();
+
+				uint end = std::max(existing.offset + existing.size, range.offset + range.size);
+
+				existing.offset = std::min(existing.offset, range.offset);
+				existing.size = end - existing.offset;
+				existing.stageFlags |= range.stageFlags;
+			}
+
+			bool isValid = true;
+			VkShaderStageFlags stages = 0;
+
+			Map<uint, Vector<VkDescriptorSetLayoutBinding>> descriptorSets;
+			Vector<VkPushConstantRange> pushConstantRanges;
+			Map<uint, uint> specializationConstants;
+			Vector<ReflectedVertexInput> vertexInputs;
+
+		};
+	}
+}
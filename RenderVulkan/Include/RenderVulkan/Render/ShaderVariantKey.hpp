@@ -0,0 +1,84 @@
+#pragma once
+
+#include "RenderVulkan/Util/Formatter.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		struct ShaderVariantKey
+		{
+			Map<uint, uint> constants;
+
+			ShaderVariantKey() = default;
+
+			ShaderVariantKey(std::initializer_list<Pair<const uint, uint>> values) : constants(values) { }
+
+			ShaderVariantKey& Set(uint constantId, uint value)
+			{
+				constants[constantId] = value;
+				return *this;
+			}
+
+			ShaderVariantKey& Set(uint constantId, bool value)
+			{
+				return Set(constantId, value ? 1u : 0u);
+			}
+
+			ShaderVariantKey& Set(uint constantId, int value)
+			{
+				return Set(constantId, static_cast<uint>(value));
+			}
+
+			ShaderVariantKey& Set(uint constantId, float value)
+			{
+				uint bits;
+				std::memcpy(&bits, &value, sizeof(bits));
+
+				return Set(constantId, bits);
+			}
+
+			bool IsEmpty() const
+			{
+				return constants.empty();
+			}
+
+			ullong Hash() const
+			{
+				ullong hash = 14695981039346656037ull;
+
+				for (const auto& [constantId, value] : constants)
+				{
+					for (ullong part : { static_cast<ullong>(constantId), static_cast<ullong>(value) })
+					{
+						for (int b = 0; b < 8; b++)
+						{
+							hash ^= (part >> (b * 8)) & 0xFF;
+							hash *= 1099511628211ull;
+						}
+					}
+				}
+
+				return hash;
+			}
+
+			String ToString() const
+			{
+				String result;
+
+				for (const auto& [constantId, value] : constants)
+					result += Formatter::Format("{}{}={}", result.empty() ? "" : ",", constantId, value);
+
+				return result;
+			}
+
+			bool operator==(const ShaderVariantKey& other) const
+			{
+				return constants == other.constants;
+			}
+		};
+	}
+}
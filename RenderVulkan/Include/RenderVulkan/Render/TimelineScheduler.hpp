@@ -0,0 +1,258 @@
+#pragma once
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Core/Profiler.hpp"
+#include "RenderVulkan/Core/Settings.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+using namespace RenderVulkan::Core;
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		struct SemaphoreWait
+		{
+			VkSemaphore semaphore = VK_NULL_HANDLE;
+			VkPipelineStageFlags stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+			ullong value = 0;
+		};
+
+		class TimelineScheduler
+		{
+
+		public:
+
+			TimelineScheduler(const TimelineScheduler&) = delete;
+			TimelineScheduler& operator=(const TimelineScheduler&) = delete;
+
+			void Initialize()
+			{
+				device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
+
+				VkSemaphoreTypeCreateInfo typeInformation{};
+
+				typeInformation.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+				typeInformation.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+				typeInformation.initialValue = 0;
+
+				VkSemaphoreCreateInfo creationInformation{};
+
+				creationInformation.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+				creationInformation.pNext = &typeInformation;
+
+				VkResult result = vkCreateSemaphore(device, &creationInformation, nullptr, &timeline);
+				Logger_ThrowIfFailed(result, "Failed to create timeline semaphore", true);
+
+				lastSubmittedValue = 0;
+				completedValue = 0;
+
+				Logger_WriteConsole("Timeline scheduler created", LogLevel::INFORMATION);
+			}
+
+			ullong Submit(VkQueue queue, const Vector<VkCommandBuffer>& commandBuffers, const Vector<SemaphoreWait>& waitSemaphores = {}, const Vector<VkSemaphore>& signalSemaphores = {}, ullong waitValue = 0, VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT)
+			{
+				Vector<VkSemaphore> waits;
+				Vector<VkPipelineStageFlags> waitStages;
+				Vector<ullong> waitValues;
+
+				for (const SemaphoreWait& wait : waitSemaphores)
+				{
+					waits.push_back(wait.semaphore);
+					waitStages.push_back(wait.stage);
+					waitValues.push_back(wait.value);
+				}
+
+				if (waitValue > 0)
+				{
+					waits.push_back(timeline);
+					waitStages.push_back(waitStage);
+					waitValues.push_back(waitValue);
+				}
+
+				Vector<VkSemaphore> signals = signalSemaphores;
+				Vector<ullong> signalValues(signals.size(), 0);
+
+				signals.push_back(timeline);
+
+				LockGuard<Mutex> lock(submitMutex);
+
+				ullong signalValue = lastSubmittedValue.load() + 1;
+
+				signalValues.push_back(signalValue);
+
+				VkTimelineSemaphoreSubmitInfo timelineInformation{};
+
+				timelineInformation.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+				timelineInformation.waitSemaphoreValueCount = static_cast<uint>(waitValues.size());
+				timelineInformation.pWaitSemaphoreValues = waitValues.data();
+				timelineInformation.signalSemaphoreValueCount = static_cast<uint>(signalValues.size());
+				timelineInformation.pSignalSemaphoreValues = signalValues.data();
+
+				VkSubmitInfo submitInformation{};
+
+				submitInformation.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+				submitInformation.pNext = &timelineInformation;
+				submitInformation.waitSemaphoreCount = static_cast<uint>(waits.size());
+				submitInformation.pWaitSemaphores = waits.data();
+				submitInformation.pWaitDstStageMask = waitStages.data();
+				submitInformation.commandBufferCount = static_cast<uint>(commandBuffers.size());
+				submitInformation.pCommandBuffers = commandBuffers.data();
+				submitInformation.signalSemaphoreCount = static_cast<uint>(signals.size());
+				submitInformation.pSignalSemaphores = signals.data();
+
+				Profiler_Scope("vkQueueSubmit");
+
+				VkResult result = vkQueueSubmit(queue, 1, &submitInformation, VK_NULL_HANDLE);
+				Logger_ThrowIfFailed(result, "Failed to submit to queue", true);
+
+				lastSubmittedValue.store(signalValue);
+
+				return signalValue;
+			}
+
+			ullong GetLastSubmittedValue() const
+			{
+				return lastSubmittedValue.load();
+			}
+
+			ullong GetCompletedValue()
+			{
+				ullong value = 0;
+
+				VkResult result = vkGetSemaphoreCounterValue(device, timeline, &value);
+				Logger_ThrowIfFailed(result, "Failed to query timeline semaphore", true);
+
+				completedValue.store(value);
+
+				return value;
+			}
+
+			bool IsComplete(ullong value)
+			{
+				return value <= completedValue.load() || value <= GetCompletedValue();
+			}
+
+			void Wait(ullong value)
+			{
+				if (value <= completedValue.load())
+					return;
+
+				Profiler_Scope("vkWaitSemaphores");
+
+				VkSemaphoreWaitInfo waitInformation{};
+
+				waitInformation.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+				waitInformation.semaphoreCount = 1;
+				waitInformation.pSemaphores = &timeline;
+				waitInformation.pValues = &value;
+
+				VkResult result = vkWaitSemaphores(device, &waitInformation, UINT64_MAX);
+				Logger_ThrowIfFailed(result, "Failed to wait for timeline semaphore", true);
+
+				GetCompletedValue();
+			}
+
+			void OnComplete(ullong value, const Function<void()>& callback)
+			{
+				{
+					LockGuard<Mutex> lock(callbackMutex);
+
+					if (timeline != VK_NULL_HANDLE)
+					{
+						pendingCallbacks[value].push_back(callback);
+						return;
+					}
+				}
+
+				callback();
+			}
+
+			void OnLastSubmittedComplete(const Function<void()>& callback)
+			{
+				OnComplete(GetLastSubmittedValue(), callback);
+			}
+
+			void Poll()
+			{
+				ullong completed = GetCompletedValue();
+
+				Vector<Function<void()>> readyCallbacks;
+
+				{
+					LockGuard<Mutex> lock(callbackMutex);
+
+					while (!pendingCallbacks.empty() && pendingCallbacks.begin()->first <= completed)
+					{
+						for (auto& callback : pendingCallbacks.begin()->second)
+							readyCallbacks.push_back(std::move(callback));
+
+						pendingCallbacks.erase(pendingCallbacks.begin());
+					}
+				}
+
+				for (auto& callback : readyCallbacks)
+					callback();
+			}
+
+			VkSemaphore GetSemaphore() const
+			{
+				return timeline;
+			}
+
+			void CleanUp()
+			{
+				if (timeline == VK_NULL_HANDLE)
+					return;
+
+				Wait(GetLastSubmittedValue());
+				Poll();
+
+				Map<ullong, Vector<Function<void()>>> remainingCallbacks;
+
+				{
+					LockGuard<Mutex> lock(callbackMutex);
+
+					vkDestroySemaphore(device, timeline, nullptr);
+					timeline = VK_NULL_HANDLE;
+
+					remainingCallbacks.swap(pendingCallbacks);
+				}
+
+				for (auto& [value, callbacks] : remainingCallbacks)
+				{
+					for (auto& callback : callbacks)
+						callback();
+				}
+			}
+
+			static Shared<TimelineScheduler> GetInstance()
+			{
+				class EnabledTimelineScheduler : public TimelineScheduler { };
+
+				static Shared<TimelineScheduler> instance = std::make_shared<EnabledTimelineScheduler>();
+
+				return instance;
+			}
+
+		private:
+
+			TimelineScheduler() = default;
+
+			VkDevice device = VK_NULL_HANDLE;
+			VkSemaphore timeline = VK_NULL_HANDLE;
+
+			Atomic<ullong> lastSubmittedValue = 0;
+			Atomic<ullong> completedValue = 0;
+
+			Mutex submitMutex;
+			Mutex callbackMutex;
+
+			Map<ullong, Vector<Function<void()>>> pendingCallbacks;
+
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+#pragma once
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Core/Settings.hpp"
+#include "RenderVulkan/Render/DescriptorSetCache.hpp"
+#include "RenderVulkan/Util/Formatter.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+#include "RenderVulkan/Util/VulkanHelper.hpp"
+
+using namespace RenderVulkan::Core;
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		class UniformRingBuffer
+		{
+
+		public:
+
+			static constexpr uint INVALID_OFFSET = NumericLimits<uint>::max();
+			static constexpr VkDeviceSize DEFAULT_FRAME_SIZE = 1024 * 1024;
+
+			UniformRingBuffer(const UniformRingBuffer&) = delete;
+			UniformRingBuffer& operator=(const UniformRingBuffer&) = delete;
+
+			void Initialize(Size framesInFlight)
+			{
+				device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
+
+				VkPhysicalDeviceProperties properties;
+				vkGetPhysicalDeviceProperties(Settings::GetInstance()->GetPointer<VkPhysicalDevice>("physicalDevice"), &properties);
+
+				alignment = std::max<VkDeviceSize>(properties.limits.minUniformBufferOffsetAlignment, 1);
+
+				VkDeviceSize requestedFrameSize = Settings::GetInstance()->Get<uint>("uniformRingBufferSize");
+
+				frameSize = AlignUp(requestedFrameSize == 0 ? DEFAULT_FRAME_SIZE : requestedFrameSize, alignment);
+				regions = Vector<Region>(std::max<Size>(framesInFlight, 1));
+
+				for (Size r = 0; r < regions.size(); r++)
+					regions[r].offset = r * frameSize;
+
+				currentRegion = &regions.front();
+
+				VulkanHelper::CreateBuffer(frameSize * regions.size(), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, buffer, bufferMemory);
+
+				VkResult result = vkMapMemory(device, bufferMemory, 0, VK_WHOLE_SIZE, 0, &mappedData);
+				Logger_ThrowIfFailed(result, "Failed to map uniform ring buffer", true);
+
+				Logger_WriteConsole(Formatter::Format("Uniform ring buffer created with '{}' regions of '{}' bytes, aligned to '{}'", regions.size(), frameSize, alignment), LogLevel::INFORMATION);
+			}
+
+			void BeginFrame(Size frameIndex)
+			{
+				currentRegion = &regions[frameIndex % regions.size()];
+			}
+
+			void Reset()
+			{
+				currentRegion->peak = std::max<VkDeviceSize>(currentRegion->peak, std::min(currentRegion->head.load(), frameSize));
+				currentRegion->head = 0;
+				currentRegion->hasOverflowed = false;
+			}
+
+			uint Allocate(const void* data, Size size)
+			{
+				Region& region = *currentRegion;
+
+				VkDeviceSize offset = region.head.fetch_add(AlignUp(size, alignment));
+
+				if (offset + size > frameSize)
+				{
+					if (!region.hasOverflowed.exchange(true))
+						Logger_WriteConsole(Formatter::Format("Uniform ring buffer region of '{}' bytes is full, raise 'uniformRingBufferSize'", frameSize), LogLevel::WARNING);
+
+					return INVALID_OFFSET;
+				}
+
+				std::memcpy(static_cast<Byte*>(mappedData) + region.offset + offset, data, size);
+
+				allocationCount++;
+
+				return static_cast<uint>(region.offset + offset);
+			}
+
+			template<typename T>
+			uint Allocate(const T& data)
+			{
+				return Allocate(&data, sizeof(T));
+			}
+
+			VkBuffer GetBuffer() const
+			{
+				return buffer;
+			}
+
+			void CleanUp()
+			{
+				if (buffer == VK_NULL_HANDLE)
+					return;
+
+				VkDeviceSize peak = 0;
+
+				for (const Region& region : regions)
+					peak = std::max<VkDeviceSize>({ peak, region.peak, std::min(region.head.load(), frameSize) });
+
+				Logger_WriteConsole(Formatter::Format("Uniform ring buffer: '{}' allocations, peak of '{}' of '{}' bytes per frame", allocationCount.load(), peak, frameSize), LogLevel::INFORMATION);
+
+				DescriptorSetCache::GetInstance()->Invalidate(buffer);
+
+				vkUnmapMemory(device, bufferMemory);
+				vkDestroyBuffer(device, buffer, nullptr);
+				vkFreeMemory(device, bufferMemory, nullptr);
+
+				buffer = VK_NULL_HANDLE;
+				bufferMemory = VK_NULL_HANDLE;
+				mappedData = nullptr;
+
+				regions.clear();
+				currentRegion = nullptr;
+				allocationCount = 0;
+			}
+
+			static Shared<UniformRingBuffer> GetInstance()
+			{
+				class EnabledUniformRingBuffer : public UniformRingBuffer { };
+
+				static Shared<UniformRingBuffer> instance = std::make_shared<EnabledUniformRingBuffer>();
+
+				return instance;
+			}
+
+		private:
+
+			struct Region
+			{
+				VkDeviceSize offset = 0;
+				Atomic<VkDeviceSize> head = 0;
+				Atomic<bool> hasOverflowed = false;
+				VkDeviceSize peak = 0;
+			};
+
+			UniformRingBuffer() = default;
+
+			static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize multiple)
+			{
+				return (value + multiple - 1) / multiple * multiple;
+			}
+
+			VkDevice device = VK_NULL_HANDLE;
+
+			VkBuffer buffer = VK_NULL_HANDLE;
+			VkDeviceMemory bufferMemory = VK_NULL_HANDLE;
+			void* mappedData = nullptr;
+
+			VkDeviceSize alignment = 256;
+			VkDeviceSize frameSize = 0;
+
+			Vector<Region> regions;
+			Region* currentRegion = nullptr;
+
+			Atomic<Size> allocationCount = 0;
+
+		};
+	}
+}
@@ -0,0 +1,332 @@
+#pragma once
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Core/Profiler.hpp"
+#include "RenderVulkan/Core/Settings.hpp"
+#include "RenderVulkan/Render/TimelineScheduler.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+#include "RenderVulkan/Util/VulkanHelper.hpp"
+
+using namespace RenderVulkan::Core;
+using namespace RenderVulkan::Util;
+
+namespace RenderVulkan
+{
+	namespace Render
+	{
+		class UploadManager
+		{
+
+		public:
+
+			UploadManager(const UploadManager&) = delete;
+			UploadManager& operator=(const UploadManager&) = delete;
+
+			void Initialize()
+			{
+				device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
+				graphicsQueue = Settings::GetInstance()->GetPointer<VkQueue>("graphicsQueue");
+				transferQueue = Settings::GetInstance()->GetPointer<VkQueue>("transferQueue");
+				graphicsQueueFamily = Settings::GetInstance()->Get<uint>("graphicsQueueFamily");
+				transferQueueFamily = Settings::GetInstance()->Get<uint>("transferQueueFamily");
+
+				isTransferQueueDedicated = transferQueue != VK_NULL_HANDLE && transferQueueFamily != graphicsQueueFamily;
+
+				if (!isTransferQueueDedicated)
+				{
+					transferQueue = graphicsQueue;
+					transferQueueFamily = graphicsQueueFamily;
+				}
+
+				transferCommandPool = CreateCommandPool(transferQueueFamily);
+
+				if (isTransferQueueDedicated)
+				{
+					acquireCommandPool = CreateCommandPool(graphicsQueueFamily);
+
+					VkSemaphoreTypeCreateInfo typeInformation{};
+
+					typeInformation.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+					typeInformation.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+					typeInformation.initialValue = 0;
+
+					VkSemaphoreCreateInfo creationInformation{};
+
+					creationInformation.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+					creationInformation.pNext = &typeInformation;
+
+					VkResult result = vkCreateSemaphore(device, &creationInformation, nullptr, &transferTimeline);
+					Logger_ThrowIfFailed(result, "Failed to create transfer timeline semaphore", true);
+
+					Logger_WriteConsole(Formatter::Format("Uploads use dedicated transfer queue family '{}'", transferQueueFamily), LogLevel::INFORMATION);
+				}
+				else
+					Logger_WriteConsole("No dedicated transfer queue family, uploads use the graphics queue", LogLevel::INFORMATION);
+			}
+
+			void UploadBuffer(VkBuffer dstBuffer, const void* data, VkDeviceSize size, VkAccessFlags dstAccessMask, VkPipelineStageFlags dstStageMask)
+			{
+				if (size == 0)
+					return;
+
+				VkBuffer stagingBuffer;
+				VkDeviceMemory stagingBufferMemory;
+
+				VulkanHelper::CreateBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
+
+				void* mappedMemory;
+
+				vkMapMemory(device, stagingBufferMemory, 0, size, 0, &mappedMemory);
+				memcpy(mappedMemory, data, static_cast<Size>(size));
+				vkUnmapMemory(device, stagingBufferMemory);
+
+				LockGuard<Mutex> lock(batchMutex);
+
+				BeginBatch();
+
+				VkBufferCopy copyRegion{};
+
+				copyRegion.srcOffset = 0;
+				copyRegion.dstOffset = 0;
+				copyRegion.size = size;
+
+				vkCmdCopyBuffer(batch.transferCommandBuffer, stagingBuffer, dstBuffer, 1, &copyRegion);
+
+				VkBufferMemoryBarrier barrier{};
+
+				barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+				barrier.buffer = dstBuffer;
+				barrier.offset = 0;
+				barrier.size = VK_WHOLE_SIZE;
+
+				if (isTransferQueueDedicated)
+				{
+					barrier.srcQueueFamilyIndex = transferQueueFamily;
+					barrier.dstQueueFamilyIndex = graphicsQueueFamily;
+
+					barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+					barrier.dstAccessMask = 0;
+
+					vkCmdPipelineBarrier(batch.transferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+					barrier.srcAccessMask = 0;
+					barrier.dstAccessMask = dstAccessMask;
+
+					vkCmdPipelineBarrier(batch.acquireCommandBuffer, dstStageMask, dstStageMask, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+				}
+				else
+				{
+					barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+					barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+					barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+					barrier.dstAccessMask = dstAccessMask;
+
+					vkCmdPipelineBarrier(batch.transferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStageMask, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+				}
+
+				batch.dstStageMask |= dstStageMask;
+				batch.stagingBuffers.push_back({ stagingBuffer, stagingBufferMemory });
+			}
+
+			ullong Flush()
+			{
+				Profiler_Function();
+
+				LockGuard<Mutex> lock(batchMutex);
+
+				if (!batch.isOpen)
+					return lastUploadValue;
+
+				UploadBatch submittedBatch = std::move(batch);
+
+				batch = {};
+
+				vkEndCommandBuffer(submittedBatch.transferCommandBuffer);
+
+				ullong value;
+
+				if (isTransferQueueDedicated)
+				{
+					vkEndCommandBuffer(submittedBatch.acquireCommandBuffer);
+
+					ullong transferValue = ++lastTransferValue;
+
+					VkTimelineSemaphoreSubmitInfo timelineInformation{};
+
+					timelineInformation.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+					timelineInformation.signalSemaphoreValueCount = 1;
+					timelineInformation.pSignalSemaphoreValues = &transferValue;
+
+					VkSubmitInfo submitInformation{};
+
+					submitInformation.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+					submitInformation.pNext = &timelineInformation;
+					submitInformation.commandBufferCount = 1;
+					submitInformation.pCommandBuffers = &submittedBatch.transferCommandBuffer;
+					submitInformation.signalSemaphoreCount = 1;
+					submitInformation.pSignalSemaphores = &transferTimeline;
+
+					VkResult result = vkQueueSubmit(transferQueue, 1, &submitInformation, VK_NULL_HANDLE);
+					Logger_ThrowIfFailed(result, "Failed to submit to transfer queue", true);
+
+					value = TimelineScheduler::GetInstance()->Submit(graphicsQueue, { submittedBatch.acquireCommandBuffer }, { { transferTimeline, submittedBatch.dstStageMask, transferValue } });
+				}
+				else
+					value = TimelineScheduler::GetInstance()->Submit(graphicsQueue, { submittedBatch.transferCommandBuffer });
+
+				TimelineScheduler::GetInstance()->OnComplete(value, [this, submittedBatch]()
+				{
+					LockGuard<Mutex> lock(batchMutex);
+
+					vkFreeCommandBuffers(device, transferCommandPool, 1, &submittedBatch.transferCommandBuffer);
+
+					if (submittedBatch.acquireCommandBuffer != VK_NULL_HANDLE)
+						vkFreeCommandBuffers(device, acquireCommandPool, 1, &submittedBatch.acquireCommandBuffer);
+
+					for (const auto& [buffer, memory] : submittedBatch.stagingBuffers)
+					{
+						vkDestroyBuffer(device, buffer, nullptr);
+						vkFreeMemory(device, memory, nullptr);
+					}
+				});
+
+				lastUploadValue = value;
+
+				return value;
+			}
+
+			ullong GetLastUploadValue() const
+			{
+				return lastUploadValue;
+			}
+
+			bool IsTransferQueueDedicated() const
+			{
+				return isTransferQueueDedicated;
+			}
+
+			void CleanUp()
+			{
+				if (transferCommandPool != VK_NULL_HANDLE)
+				{
+					vkDestroyCommandPool(device, transferCommandPool, nullptr);
+					transferCommandPool = VK_NULL_HANDLE;
+				}
+
+				if (acquireCommandPool != VK_NULL_HANDLE)
+				{
+					vkDestroyCommandPool(device, acquireCommandPool, nullptr);
+					acquireCommandPool = VK_NULL_HANDLE;
+				}
+
+				if (transferTimeline != VK_NULL_HANDLE)
+				{
+					vkDestroySemaphore(device, transferTimeline, nullptr);
+					transferTimeline = VK_NULL_HANDLE;
+				}
+			}
+
+			static Shared<UploadManager> GetInstance()
+			{
+				class EnabledUploadManager : public UploadManager { };
+
+				static Shared<UploadManager> instance = std::make_shared<EnabledUploadManager>();
+
+				return instance;
+			}
+
+		private:
+
+			struct UploadBatch
+			{
+				bool isOpen = false;
+
+				VkCommandBuffer transferCommandBuffer = VK_NULL_HANDLE;
+				VkCommandBuffer acquireCommandBuffer = VK_NULL_HANDLE;
+
+				VkPipelineStageFlags dstStageMask = 0;
+
+				Vector<Pair<VkBuffer, VkDeviceMemory>> stagingBuffers;
+			};
+
+			UploadManager() = default;
+
+			VkCommandPool CreateCommandPool(uint queueFamily)
+			{
+				VkCommandPoolCreateInfo poolInformation = {};
+
+				poolInformation.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+				poolInformation.queueFamilyIndex = queueFamily;
+				poolInformation.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+				VkCommandPool commandPool;
+
+				VkResult result = vkCreateCommandPool(device, &poolInformation, nullptr, &commandPool);
+				Logger_ThrowIfFailed(result, "Failed to create upload command pool", true);
+
+				return commandPool;
+			}
+
+			VkCommandBuffer BeginCommandBuffer(VkCommandPool commandPool)
+			{
+				VkCommandBufferAllocateInfo allocationInformation{};
+
+				allocationInformation.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+				allocationInformation.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+				allocationInformation.commandPool = commandPool;
+				allocationInformation.commandBufferCount = 1;
+
+				VkCommandBuffer commandBuffer;
+
+				VkResult result = vkAllocateCommandBuffers(device, &allocationInformation, &commandBuffer);
+				Logger_ThrowIfFailed(result, "Failed to allocate upload command buffer", true);
+
+				VkCommandBufferBeginInfo beginInformation{};
+
+				beginInformation.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+				beginInformation.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+				vkBeginCommandBuffer(commandBuffer, &beginInformation);
+
+				return commandBuffer;
+			}
+
+			void BeginBatch()
+			{
+				if (batch.isOpen)
+					return;
+
+				batch.transferCommandBuffer = BeginCommandBuffer(transferCommandPool);
+
+				if (isTransferQueueDedicated)
+					batch.acquireCommandBuffer = BeginCommandBuffer(acquireCommandPool);
+
+				batch.isOpen = true;
+			}
+
+			VkDevice device = VK_NULL_HANDLE;
+
+			VkQueue graphicsQueue = VK_NULL_HANDLE;
+			VkQueue transferQueue = VK_NULL_HANDLE;
+
+			uint graphicsQueueFamily = 0;
+			uint transferQueueFamily = 0;
+
+			bool isTransferQueueDedicated = false;
+
+			VkCommandPool transferCommandPool = VK_NULL_HANDLE;
+			VkCommandPool acquireCommandPool = VK_NULL_HANDLE;
+
+			VkSemaphore transferTimeline = VK_NULL_HANDLE;
+			ullong lastTransferValue = 0;
+			ullong lastUploadValue = 0;
+
+			Mutex batchMutex;
+			UploadBatch batch;
+
+		};
+	}
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+using namespace RenderVulkan::Core;
+
+namespace RenderVulkan
+{
+	namespace Util
+	{
+		class FileWatcher
+		{
+
+		public:
+
+			FileWatcher(const FileWatcher&) = delete;
+			FileWatcher& operator=(const FileWatcher&) = delete;
+
+			~FileWatcher()
+			{
+				Stop();
+			}
+
+			void Start(const Vector<Path>& watchedDirectories, const String& watchedExtension, Milliseconds interval, const Function<void(const Vector<Path>&)>& onChanged)
+			{
+				Stop();
+
+				directories = watchedDirectories;
+				extension = watchedExtension;
+				callback = onChanged;
+				pollInterval = interval;
+
+				knownFiles = Scan();
+				pendingFiles.clear();
+
+				isStopping = false;
+				watchThread = Thread([this] { Run(); });
+			}
+
+			void Stop()
+			{
+				{
+					LockGuard<Mutex> lock(mutex);
+
+					isStopping = true;
+				}
+
+				wakeUp.notify_all();
+
+				if (watchThread.joinable())
+					watchThread.join();
+			}
+
+			bool IsRunning() const
+			{
+				return watchThread.joinable();
+			}
+
+			static Unique<FileWatcher> Create()
+			{
+				class EnabledFileWatcher : public FileWatcher { };
+
+				return std::make_unique<EnabledFileWatcher>();
+			}
+
+		private:
+
+			struct FileState
+			{
+				std::filesystem::file_time_type writeTime;
+				uintmax_t size = 0;
+
+				bool operator==(const FileState& other) const
+				{
+					return writeTime == other.writeTime && size == other.size;
+				}
+			};
+
+			FileWatcher() = default;
+
+			void Run()
+			{
+				while (true)
+				{
+					{
+						UniqueLock lock(mutex);
+
+						if (wakeUp.wait_for(lock, pollInterval, [this] { return isStopping; }))
+							return;
+					}
+
+					Vector<Path> changed = Poll();
+
+					if (!changed.empty())
+						callback(changed);
+				}
+			}
+
+			Vector<Path> Poll()
+			{
+				Map<Path, FileState> currentFiles = Scan();
+				Vector<Path> changed;
+
+				for (const auto& [path, state] : currentFiles)
+				{
+					bool isModified = !knownFiles.contains(path) || !(knownFiles.at(path) == state);
+
+					if (isModified)
+					{
+						pendingFiles[path] = state;
+						continue;
+					}
+
+					if (pendingFiles.contains(path) && pendingFiles.at(path) == state)
+					{
+						changed.push_back(path);
+						pendingFiles.erase(path);
+					}
+				}
+
+				knownFiles = std::move(currentFiles);
+
+				return changed;
+			}
+
+			Map<Path, FileState> Scan() const
+			{
+				Map<Path, FileState> files;
+				std::error_code error;
+
+				for (const Path& directory : directories)
+				{
+					if (!std::filesystem::is_directory(directory, error))
+						continue;
+
+					for (std::filesystem::recursive_directory_iterator iterator(directory, error), end; !error && iterator != end; iterator.increment(error))
+					{
+						std::error_code fileError;
+
+						if (!iterator->is_regular_file(fileError) || iterator->path().extension() != extension)
+							continue;
+
+						FileState state;
+
+						state.writeTime = iterator->last_write_time(fileError);
+						state.size = iterator->file_size(fileError);
+
+						if (!fileError)
+							files[iterator->path().lexically_normal()] = state;
+					}
+				}
+
+				return files;
+			}
+
+			Vector<Path> directories;
+			String extension;
+			Function<void(const Vector<Path>&)> callback;
+			Milliseconds pollInterval = Milliseconds(250);
+
+			Map<Path, FileState> knownFiles;
+			Map<Path, FileState> pendingFiles;
+
+			Mutex mutex;
+			ConditionVariable wakeUp;
+			Thread watchThread;
+			bool isStopping = false;
+
+		};
+	}
+}
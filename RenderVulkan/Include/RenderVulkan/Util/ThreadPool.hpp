@@ -0,0 +1,155 @@
+#pragma once
+
+#include "RenderVulkan/Util/Typedefs.hpp"
+
+namespace RenderVulkan
+{
+	namespace Util
+	{
+		class ThreadPool
+		{
+
+		public:
+
+			ThreadPool(const ThreadPool&) = delete;
+			ThreadPool& operator=(const ThreadPool&) = delete;
+
+			~ThreadPool()
+			{
+				Stop();
+			}
+
+			void Dispatch(Size count, const Function<void(Size)>& job)
+			{
+				if (count == 0)
+					return;
+
+				{
+					UniqueLock lock(mutex);
+
+					currentJob = job;
+					jobCount = count;
+					nextJob = 0;
+					remainingJobs = count;
+				}
+
+				workAvailable.notify_all();
+
+				RunJobs();
+
+				UniqueLock lock(mutex);
+
+				workFinished.wait(lock, [this] { return remainingJobs == 0; });
+
+				currentJob = nullptr;
+				jobCount = 0;
+			}
+
+			Size GetThreadCount() const
+			{
+				return workers.size() + 1;
+			}
+
+			void Stop()
+			{
+				{
+					UniqueLock lock(mutex);
+
+					if (isStopping)
+						return;
+
+					isStopping = true;
+				}
+
+				workAvailable.notify_all();
+
+				for (Thread& worker : workers)
+				{
+					if (worker.joinable())
+						worker.join();
+				}
+
+				workers.clear();
+			}
+
+			static Unique<ThreadPool> Create(Size threadCount)
+			{
+				class EnabledThreadPool : public ThreadPool { };
+
+				Unique<ThreadPool> threadPool = std::make_unique<EnabledThreadPool>();
+
+				for (Size t = 1; t < std::max<Size>(threadCount, 1); t++)
+					threadPool->workers.emplace_back([pool = threadPool.get()] { pool->WorkerLoop(); });
+
+				return threadPool;
+			}
+
+		private:
+
+			ThreadPool() = default;
+
+			void WorkerLoop()
+			{
+				while (true)
+				{
+					{
+						UniqueLock lock(mutex);
+
+						workAvailable.wait(lock, [this] { return isStopping || nextJob < jobCount; });
+
+						if (isStopping)
+							return;
+					}
+
+					RunJobs();
+				}
+			}
+
+			void RunJobs()
+			{
+				while (true)
+				{
+					Size index;
+					Function<void(Size)> job;
+
+					{
+						LockGuard<Mutex> lock(mutex);
+
+						if (nextJob >= jobCount)
+							return;
+
+						index = nextJob++;
+						job = currentJob;
+					}
+
+					job(index);
+
+					bool finished;
+
+					{
+						LockGuard<Mutex> lock(mutex);
+
+						finished = --remainingJobs == 0;
+					}
+
+					if (finished)
+						workFinished.notify_all();
+				}
+			}
+
+			Vector<Thread> workers;
+
+			Mutex mutex;
+			ConditionVariable workAvailable;
+			ConditionVariable workFinished;
+
+			Function<void(Size)> currentJob;
+			Size jobCount = 0;
+			Size nextJob = 0;
+			Size remainingJobs = 0;
+
+			bool isStopping = false;
+
+		};
+	}
+}
\ No newline at end of file
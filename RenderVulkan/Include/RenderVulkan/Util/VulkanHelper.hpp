@@ -3,6 +3,7 @@
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 #include "RenderVulkan/Core/Logger.hpp"
+#include "RenderVulkan/Core/Settings.hpp"
 #include "RenderVulkan/Core/Window.hpp"
 #include "RenderVulkan/Render/QueueFamilyIndices.hpp"
 #include "RenderVulkan/Render/SwapChainSupportDetails.hpp"
@@ -22,15 +23,16 @@ namespace RenderVulkan
 			VulkanHelper(const VulkanHelper&) = delete;
 			VulkanHelper& operator=(const VulkanHelper&) = delete;
 
-			static Vector<const char*> GetRequiredExtensions(bool enableValidationLayers, Vector<const char*> validationLayers)
+			static Vector<const char*> GetRequiredExtensions(bool enableValidationLayers, Vector<const char*> validationLayers, bool headless = false)
 			{
 				if (enableValidationLayers && !CheckValidationLayerSupport(validationLayers))
 					Logger_ThrowException("Validation layers requested, but not available", true);
 
 				uint glfwExtensionCount = 0;
-				const char** glfwExtensions;
+				const char** glfwExtensions = nullptr;
 
-				glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+				if (!headless)
+					glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
 
 				Vector<const char*> requiredExtensions;
 
@@ -109,27 +111,6 @@ namespace RenderVulkan
 				return details;
 			}
 
-			static bool IsDeviceCompatable(VkPhysicalDevice device, Vector<const char*> deviceExtensions, VkSurfaceKHR surface) 
-			{
-				VkPhysicalDeviceProperties deviceProperties;
-				vkGetPhysicalDeviceProperties(device, &deviceProperties);
-
-				VkPhysicalDeviceFeatures deviceFeatures;
-				vkGetPhysicalDeviceFeatures(device, &deviceFeatures);
-
-				bool extensionsSupported = CheckDeviceExtensionSupport(device, deviceExtensions);
-
-				bool swapChainAdequate = false;
-
-				if (extensionsSupported) 
-				{
-					SwapChainSupportDetails swapChainSupport = GetSwapChainSupport(device, surface);
-					swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
-				}
-
-				return (deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU && deviceFeatures.geometryShader && deviceFeatures.tessellationShader) && FindQueueFamilies(device, surface).IsSet() && extensionsSupported && swapChainAdequate;
-			}
-
 			static QueueFamilyIndices FindQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface) 
 			{
 				QueueFamilyIndices indices = {};
@@ -148,7 +129,11 @@ namespace RenderVulkan
 						indices.graphicsFamily = i;
 
 					VkBool32 presentSupport = false;
-					vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+
+					if (surface != VK_NULL_HANDLE)
+						vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+					else
+						presentSupport = (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
 
 					if (presentSupport) 
 						indices.presentFamily = i;
@@ -250,6 +235,34 @@ namespace RenderVulkan
 				return VK_SAMPLE_COUNT_1_BIT;
 			}
 
+			static VkFormat FindDepthFormat(VkPhysicalDevice physicalDevice)
+			{
+				for (VkFormat format : { VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT })
+				{
+					VkFormatProperties properties;
+					vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &properties);
+
+					if (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT)
+						return format;
+				}
+
+				Logger_ThrowException("Failed to find a supported depth format", true);
+			}
+
+			static VkFormat FindColorFormat(VkPhysicalDevice physicalDevice)
+			{
+				for (VkFormat format : { VK_FORMAT_B8G8R8A8_SRGB, VK_FORMAT_R8G8B8A8_SRGB, VK_FORMAT_B8G8R8A8_UNORM, VK_FORMAT_R8G8B8A8_UNORM })
+				{
+					VkFormatProperties properties;
+					vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &properties);
+
+					if ((properties.optimalTilingFeatures & VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT) && (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_TRANSFER_SRC_BIT))
+						return format;
+				}
+
+				Logger_ThrowException("Failed to find a supported color format", true);
+			}
+
 			static uint FindMemoryType(uint typeFilter, VkMemoryPropertyFlags properties)
 			{
 				VkPhysicalDevice physicalDevice = Settings::GetInstance()->GetPointer<VkPhysicalDevice>("physicalDevice");
@@ -266,6 +279,36 @@ namespace RenderVulkan
 				Logger_ThrowException("Failed to find suitable memory type!", false);
 			}
 
+			static void CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory)
+			{
+				VkDevice device = Settings::GetInstance()->GetPointer<VkDevice>("logicalDevice");
+
+				VkBufferCreateInfo bufferInfo{};
+
+				bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+				bufferInfo.size = size;
+				bufferInfo.usage = usage;
+				bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+				VkResult result = vkCreateBuffer(device, &bufferInfo, nullptr, &buffer);
+				Logger_ThrowIfFailed(result, "Failed to create buffer!", false);
+
+				VkMemoryRequirements memRequirements;
+
+				vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
+
+				VkMemoryAllocateInfo allocInfo{};
+
+				allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+				allocInfo.allocationSize = memRequirements.size;
+				allocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, properties);
+
+				result = vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory);
+				Logger_ThrowIfFailed(result, "Failed to allocate buffer memory!", false);
+
+				vkBindBufferMemory(device, buffer, bufferMemory, 0);
+			}
+
 		private:
 
 			VulkanHelper() = default;
@@ -1,30 +1,78 @@
 #define GLM_ENABLE_EXPERIMENTAL
 
+#include "RenderVulkan/Core/Profiler.hpp"
 #include "RenderVulkan/Core/Settings.hpp"
 #include "RenderVulkan/Core/Window.hpp"
 #include "RenderVulkan/Engine.hpp"
 
-int main()
+int main(int argc, char** argv)
 {
 	try
 	{
 		RenderVulkan::Core::Settings::GetInstance()->Set<String>("defaultDomain", "RenderVulkan");
+
+		for (int a = 1; a < argc; a++)
+		{
+			String argument = argv[a];
+
+			if (argument == "--headless")
+				RenderVulkan::Core::Settings::GetInstance()->Set<bool>("headless", true);
+			else if (argument == "--frames" && a + 1 < argc)
+				RenderVulkan::Core::Settings::GetInstance()->Set<uint>("headlessFrameCount", static_cast<uint>(std::stoul(argv[++a])));
+			else if (argument == "--device" && a + 1 < argc)
+				RenderVulkan::Core::Settings::GetInstance()->Set<String>("preferredDevice", argv[++a]);
+			else if (argument == "--depth-prepass")
+				RenderVulkan::Core::Settings::GetInstance()->Set<bool>("depthPrepass", true);
+			else if (argument == "--hot-reload")
+				RenderVulkan::Core::Settings::GetInstance()->Set<bool>("shaderHotReload", true);
+			else if (argument == "--static-pipeline-state")
+				RenderVulkan::Core::Settings::GetInstance()->Set<bool>("staticPipelineState", true);
+			else if (argument == "--bindless")
+				RenderVulkan::Core::Settings::GetInstance()->Set<bool>("bindless", true);
+			else if (argument == "--msaa" && a + 1 < argc)
+				RenderVulkan::Core::Settings::GetInstance()->Set<uint>("msaaSamples", static_cast<uint>(std::stoul(argv[++a])));
+			else if (argument == "--capture" && a + 1 < argc)
+				RenderVulkan::Core::Settings::GetInstance()->Set<uint>("profilerCaptureFrames", static_cast<uint>(std::stoul(argv[++a])));
+		}
+
 		RenderVulkan::Engine::GetInstance()->PreInitialize();
-	
-		RenderVulkan::Core::Window::GetInstance()->Create(RenderVulkan::Core::Settings::GetInstance()->Get<String>("windowTitle"), RenderVulkan::Core::Settings::GetInstance()->Get<Vector2i>("windowDimensions"));
+
+		bool headless = RenderVulkan::Core::Settings::GetInstance()->Get<bool>("headless");
+
+		if (!headless)
+			RenderVulkan::Core::Window::GetInstance()->Create(RenderVulkan::Core::Settings::GetInstance()->Get<String>("windowTitle"), RenderVulkan::Core::Settings::GetInstance()->Get<Vector2i>("windowDimensions"));
 
 		RenderVulkan::Engine::GetInstance()->Initialize();
 
-		while (!RenderVulkan::Core::Window::GetInstance()->ShouldClose())
+		if (headless)
 		{
-			RenderVulkan::Engine::GetInstance()->Update();
+			uint frameCount = RenderVulkan::Core::Settings::GetInstance()->Get<uint>("headlessFrameCount");
 
-			RenderVulkan::Core::Window::GetInstance()->Update();
-			RenderVulkan::Engine::GetInstance()->Render();
+			for (uint frame = 0; frameCount == 0 || frame < frameCount; frame++)
+			{
+				RenderVulkan::Engine::GetInstance()->Update();
+				RenderVulkan::Engine::GetInstance()->Render();
+
+				Profiler_EndFrame();
+			}
+		}
+		else
+		{
+			while (!RenderVulkan::Core::Window::GetInstance()->ShouldClose())
+			{
+				RenderVulkan::Engine::GetInstance()->Update();
+
+				RenderVulkan::Core::Window::GetInstance()->Update();
+				RenderVulkan::Engine::GetInstance()->Render();
+
+				Profiler_EndFrame();
+			}
 		}
 
 		RenderVulkan::Engine::GetInstance()->CleanUp();
-		RenderVulkan::Core::Window::GetInstance()->CleanUp();
+
+		if (!headless)
+			RenderVulkan::Core::Window::GetInstance()->CleanUp();
 	}
 	catch (const std::exception& exception)
 	{